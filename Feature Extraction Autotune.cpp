@@ -0,0 +1,52 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+    #define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Library/Feature Extraction.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+
+// +------------------------------------------------< MAIN >------------------------------------------------+
+
+// Usage: "Feature Extraction Autotune" [profile file] [width] [height]
+// Benchmarks the operator variants on this machine and writes the winners to the profile that the other
+// programs load at startup.
+int main(int argc, char* argv[])
+{
+    static const char* OUTPUT_PROFILE_FILE_NAME = "Feature Extraction.profile";
+
+    const char* profileFileName = (argc > 1) ? argv[1] : OUTPUT_PROFILE_FILE_NAME;
+    const SIZE  imageSize       = { (argc > 2) ? atoi(argv[2]) : 512, (argc > 3) ? atoi(argv[3]) : 512 };
+
+    if (imageSize.cx <= 2 * MAX_TUNED_WINDOW_SIZE || imageSize.cy <= 2 * MAX_TUNED_WINDOW_SIZE)
+    {
+        fprintf(stderr, "image size must exceed %d x %d\n", 2 * MAX_TUNED_WINDOW_SIZE, 2 * MAX_TUNED_WINDOW_SIZE);
+
+        return 1;
+    }
+
+    TuningProfile profile = TuneProfile(imageSize);
+
+    printf("sobel variant           : %s\n", (profile.sobelVariant == CONVOLUTION_VARIANT_DIRECT) ? "direct" : "separable");
+    printf("convolution band height : %d\n", profile.convolutionBandHeight);
+    printf("thread count            : %d\n", profile.threadCount);
+
+    for (int size = 3; size <= MAX_TUNED_WINDOW_SIZE; size += 2)
+        printf("window %2d x %-2d         : %s\n", size, size, (profile.windowVariant[size / 2] == WINDOW_VARIANT_RUNNING) ? "running" : "scan");
+
+    if (!SaveTuningProfile(profileFileName, &profile))
+    {
+        perror(profileFileName);
+
+        return 1;
+    }
+
+    return 0;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
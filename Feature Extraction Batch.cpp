@@ -0,0 +1,400 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+    #define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Library/Feature Extraction.hpp"
+
+#include <sys/stat.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// +------------------------------------------------< TYPE >------------------------------------------------+
+
+struct BatchOperator
+{
+    const char* name;
+    bool        thresholded;
+};
+
+// A job is one line of the job file: input, width, height, operator, wsize, parameter and output separated
+// by tabs, so that file names may contain spaces. parameter is lamda for harris_corner and otherwise the edge
+// ratio of the threshold applied to the result, where 0 keeps the unthresholded edge image.
+struct BatchJob
+{
+    std::string line;
+    std::string inputFileName;
+    std::string outputFileName;
+    SIZE        imageSize;
+    int         operation;
+    int         wsize;
+    double      parameter;
+};
+
+// The manifest remembers, per job line, the input file's size and modification time when it was last run and
+// the cache key of its result, so that an unchanged job is skipped without even reading its input.
+struct ManifestEntry
+{
+    std::string    line;
+    uint64_t       inputSize;
+    int64_t        inputTime;
+    ResultCacheKey key;
+};
+
+// +-----------------------------------------------< GLOBAL >-----------------------------------------------+
+
+static const BatchOperator BATCH_OPERATORS[] =
+{
+    { "sobel_edge",            true  },
+    { "harris_corner",         false },
+    { "dilation_edge",         true  },
+    { "erosion_edge",          true  },
+    { "unbias_edge",           false },
+    { "unbias_threshold_edge", false },
+    { "entropy_sketch_edge",   true  },
+    { "dp_edge",               true  },
+    { "dip_edge",              true  }
+};
+
+static const int BATCH_OPERATOR_COUNT = sizeof(BATCH_OPERATORS) / sizeof(BatchOperator);
+
+static const char* INTEGRAL_IMAGE_NAME = "integral_image";
+
+// +------------------------------------------------< JOB >-------------------------------------------------+
+
+static bool ParseJob(const char* line, BatchJob* job)
+{
+    std::vector<std::string> fields;
+    std::string              field;
+
+    for (const char* character = line; *character != '\0' && *character != '\r' && *character != '\n'; ++character)
+    {
+        if (*character == '\t')
+        {
+            fields.push_back(field);
+            field.clear();
+        }
+        else
+            field += *character;
+    }
+
+    fields.push_back(field);
+
+    if (fields.size() != 7)
+        return false;
+
+    job->line           = line;
+    job->line           = job->line.substr(0, job->line.find_first_of("\r\n"));
+    job->inputFileName  = fields[0];
+    job->imageSize      = { atoi(fields[1].c_str()), atoi(fields[2].c_str()) };
+    job->operation      = -1;
+    job->wsize          = atoi(fields[4].c_str());
+    job->parameter      = atof(fields[5].c_str());
+    job->outputFileName = fields[6];
+
+    for (int operation = 0; operation < BATCH_OPERATOR_COUNT; ++operation)
+        if (fields[3] == BATCH_OPERATORS[operation].name)
+            job->operation = operation;
+
+    return job->operation >= 0 && job->imageSize.cx > 0 && job->imageSize.cy > 0 && job->wsize > 0 && job->wsize % 2 == 1 &&
+           job->imageSize.cx > 2 * job->wsize && job->imageSize.cy > 2 * job->wsize;
+}
+
+static bool ReadFileStatus(const char* fileName, uint64_t* size, int64_t* time)
+{
+    struct stat status;
+
+    if (stat(fileName, &status) != 0)
+        return false;
+
+    *size = static_cast<uint64_t>(status.st_size);
+#if defined(__linux__)
+    *time = static_cast<int64_t>(status.st_mtim.tv_sec) * 1000000000 + status.st_mtim.tv_nsec;
+#else
+    *time = static_cast<int64_t>(status.st_mtime) * 1000000000;
+#endif
+
+    return true;
+}
+
+static bool WriteRawFile(const char* fileName, const byte_t* image, const size_t size)
+{
+    FILE* fileStream = fopen(fileName, "wb");
+
+    if (fileStream == NULL)
+        return false;
+
+    bool succeeded = fwrite(image, sizeof(byte_t), size, fileStream) == size;
+
+    return (fclose(fileStream) == 0) && succeeded;
+}
+
+// The entropy sketch takes the integral image of its input from the cache, where it is shared by every window
+// size and edge ratio run on the same input.
+static void ExecuteJob(const BatchJob* job, const byte_t* inputImage, byte_t* outputImage, const char* cacheDirectory, const uint64_t inputHash)
+{
+    const SIZE imageSize = job->imageSize;
+    const SIZE wsize     = { job->wsize, job->wsize };
+    const int  operation = job->operation;
+
+    if (strcmp(BATCH_OPERATORS[operation].name, "sobel_edge") == 0)
+        SobelEdge(inputImage, outputImage, imageSize);
+    else if (strcmp(BATCH_OPERATORS[operation].name, "harris_corner") == 0)
+        HarrisCorner(inputImage, outputImage, imageSize, job->wsize, job->parameter);
+    else if (strcmp(BATCH_OPERATORS[operation].name, "dilation_edge") == 0)
+        DilationEdge(inputImage, outputImage, imageSize, wsize);
+    else if (strcmp(BATCH_OPERATORS[operation].name, "erosion_edge") == 0)
+        ErosionEdge(inputImage, outputImage, imageSize, wsize);
+    else if (strcmp(BATCH_OPERATORS[operation].name, "unbias_edge") == 0)
+        UnbiasEdge(inputImage, outputImage, imageSize, wsize);
+    else if (strcmp(BATCH_OPERATORS[operation].name, "unbias_threshold_edge") == 0)
+    {
+        byte_t* unbiasEdgeImage = new byte_t[imageSize.cx * imageSize.cy];
+
+        UnbiasEdge(inputImage, unbiasEdgeImage, imageSize, wsize);
+        LocalVarianceThreshold(inputImage, unbiasEdgeImage, outputImage, imageSize, wsize);
+
+        delete[] unbiasEdgeImage;
+    }
+    else if (strcmp(BATCH_OPERATORS[operation].name, "entropy_sketch_edge") == 0)
+    {
+        const ResultCacheKey integralKey = CreateResultCacheKey(inputHash, INTEGRAL_IMAGE_NAME, imageSize, { 0, 0 }, 0.0, 0.0);
+        CachedResult*        integral    = MapCachedResult(cacheDirectory, integralKey);
+
+        if (integral == NULL)
+        {
+            lbyte_t* integralImage = CreateIntegralImage(inputImage, new lbyte_t[imageSize.cx * imageSize.cy], imageSize);
+
+            StoreCachedResult(cacheDirectory, integralKey, imageSize, sizeof(lbyte_t), integralImage);
+            EntropySketchEdge(inputImage, outputImage, imageSize, wsize, integralImage, NULL);
+
+            delete[] integralImage;
+        }
+        else
+        {
+            EntropySketchEdge(inputImage, outputImage, imageSize, wsize, static_cast<const lbyte_t*>(integral->data), NULL);
+
+            ReleaseCachedResult(integral);
+        }
+    }
+    else if (strcmp(BATCH_OPERATORS[operation].name, "dp_edge") == 0)
+        DPEdge(inputImage, outputImage, imageSize, wsize);
+    else
+        DIPEdge(inputImage, outputImage, imageSize, wsize);
+
+    if (BATCH_OPERATORS[operation].thresholded && job->parameter > 0.0)
+    {
+        if (strcmp(BATCH_OPERATORS[operation].name, "entropy_sketch_edge") == 0)
+            MinEdgeRatioThreshold(outputImage, outputImage, imageSize, job->parameter);
+        else
+            MaxEdgeRatioThreshold(outputImage, outputImage, imageSize, job->parameter);
+    }
+}
+
+// +----------------------------------------------< MANIFEST >----------------------------------------------+
+
+static void LoadManifest(const char* fileName, std::vector<ManifestEntry>& manifest)
+{
+    FILE* fileStream = fopen(fileName, "rb");
+    char  line[4096];
+
+    if (fileStream == NULL)
+        return;
+
+    while (fgets(line, sizeof(line), fileStream) != NULL)
+    {
+        ManifestEntry      entry;
+        unsigned long long inputSize;
+        long long          inputTime;
+        unsigned long long inputHash;
+        unsigned long long parameterHash;
+        int                length = 0;
+
+        if (sscanf(line, "%llu %lld %llx %llx %n", &inputSize, &inputTime, &inputHash, &parameterHash, &length) != 4 || length == 0)
+            continue;
+
+        entry.line              = line + length;
+        entry.line              = entry.line.substr(0, entry.line.find_first_of("\r\n"));
+        entry.inputSize         = inputSize;
+        entry.inputTime         = inputTime;
+        entry.key.inputHash     = inputHash;
+        entry.key.parameterHash = parameterHash;
+
+        manifest.push_back(entry);
+    }
+
+    fclose(fileStream);
+}
+
+static bool SaveManifest(const char* fileName, const std::vector<ManifestEntry>& manifest)
+{
+    std::string temporaryName = std::string(fileName) + ".partial";
+    FILE*       fileStream    = fopen(temporaryName.c_str(), "wb");
+
+    if (fileStream == NULL)
+        return false;
+
+    for (size_t index = 0; index < manifest.size(); ++index)
+        fprintf(fileStream, "%llu %lld %016llx %016llx %s\n", static_cast<unsigned long long>(manifest[index].inputSize), static_cast<long long>(manifest[index].inputTime),
+                static_cast<unsigned long long>(manifest[index].key.inputHash), static_cast<unsigned long long>(manifest[index].key.parameterHash), manifest[index].line.c_str());
+
+    if (fclose(fileStream) != 0)
+        return false;
+
+    remove(fileName);
+
+    return rename(temporaryName.c_str(), fileName) == 0;
+}
+
+static ManifestEntry* FindManifestEntry(std::vector<ManifestEntry>& manifest, const std::string& line)
+{
+    for (size_t index = 0; index < manifest.size(); ++index)
+        if (manifest[index].line == line)
+            return &manifest[index];
+
+    return NULL;
+}
+
+// +------------------------------------------------< MAIN >------------------------------------------------+
+
+// Usage: "Feature Extraction Batch" [job file] [cache directory]
+// Runs every job of the job file, skipping the ones whose input is unchanged since the manifest recorded them
+// and taking the results of inputs already computed with the same parameters from the cache. The cache
+// directory must exist; the manifest is kept in it.
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        fprintf(stderr, "usage: %s [job file] [cache directory]\n", argv[0]);
+
+        return 1;
+    }
+
+    const char*       jobFileName    = argv[1];
+    const char*       cacheDirectory = argv[2];
+    const std::string manifestName   = std::string(cacheDirectory) + "/manifest";
+
+    std::vector<ManifestEntry> manifest;
+    FILE*                      jobStream = fopen(jobFileName, "rb");
+    char                       line[4096];
+    int                        failedCount = 0;
+
+    if (jobStream == NULL)
+    {
+        perror(jobFileName);
+
+        return 1;
+    }
+
+    LoadDefaultTuningProfile();
+    LoadManifest(manifestName.c_str(), manifest);
+
+    while (fgets(line, sizeof(line), jobStream) != NULL)
+    {
+        BatchJob job;
+        uint64_t inputSize;
+        int64_t  inputTime;
+
+        if (line[0] == '#' || line[0] == '\r' || line[0] == '\n')
+            continue;
+
+        if (!ParseJob(line, &job) || !ReadFileStatus(job.inputFileName.c_str(), &inputSize, &inputTime) ||
+            inputSize != static_cast<uint64_t>(job.imageSize.cx) * job.imageSize.cy)
+        {
+            fprintf(stderr, "invalid job: %s", line);
+            ++failedCount;
+
+            continue;
+        }
+
+        ManifestEntry* entry = FindManifestEntry(manifest, job.line);
+        uint64_t       outputSize;
+        int64_t        outputTime;
+
+        if (entry != NULL && entry->inputSize == inputSize && entry->inputTime == inputTime &&
+            ReadFileStatus(job.outputFileName.c_str(), &outputSize, &outputTime) && outputSize == inputSize)
+        {
+            printf("unchanged %s\n", job.outputFileName.c_str());
+
+            continue;
+        }
+
+        const size_t pixelCount  = static_cast<size_t>(job.imageSize.cx) * job.imageSize.cy;
+        byte_t*      inputImage  = new byte_t[pixelCount];
+        byte_t*      outputImage = new byte_t[pixelCount];
+        FILE*        inputStream = fopen(job.inputFileName.c_str(), "rb");
+        bool         loaded      = inputStream != NULL && fread(inputImage, sizeof(byte_t), pixelCount, inputStream) == pixelCount;
+
+        if (inputStream != NULL)
+            fclose(inputStream);
+
+        if (loaded)
+        {
+            const uint64_t       inputHash = HashBytes(inputImage, pixelCount);
+            const double         edgeRatio = (BATCH_OPERATORS[job.operation].thresholded) ? (job.parameter) : (0.0);
+            const double         lamda     = (BATCH_OPERATORS[job.operation].thresholded) ? (0.0) : (job.parameter);
+            const ResultCacheKey key       = CreateResultCacheKey(inputHash, BATCH_OPERATORS[job.operation].name, job.imageSize, { job.wsize, job.wsize }, edgeRatio, lamda);
+            CachedResult*        cached    = MapCachedResult(cacheDirectory, key);
+            bool                 written   = false;
+
+            if (cached != NULL && cached->header->elementSize == sizeof(byte_t) && cached->header->dataSize == pixelCount)
+            {
+                written = WriteRawFile(job.outputFileName.c_str(), static_cast<const byte_t*>(cached->data), pixelCount);
+
+                printf("cached    %s\n", job.outputFileName.c_str());
+            }
+            else
+            {
+                ExecuteJob(&job, inputImage, outputImage, cacheDirectory, inputHash);
+                StoreCachedResult(cacheDirectory, key, job.imageSize, sizeof(byte_t), outputImage);
+
+                written = WriteRawFile(job.outputFileName.c_str(), outputImage, pixelCount);
+
+                printf("computed  %s\n", job.outputFileName.c_str());
+            }
+
+            ReleaseCachedResult(cached);
+
+            if (written)
+            {
+                ManifestEntry updated = { job.line, inputSize, inputTime, key };
+
+                if (entry != NULL)
+                    *entry = updated;
+                else
+                    manifest.push_back(updated);
+            }
+            else
+                loaded = false;
+        }
+
+        if (!loaded)
+        {
+            fprintf(stderr, "failed job: %s", line);
+            ++failedCount;
+        }
+
+        delete[] inputImage;
+        delete[] outputImage;
+    }
+
+    fclose(jobStream);
+
+    if (!SaveManifest(manifestName.c_str(), manifest))
+    {
+        perror(manifestName.c_str());
+
+        return 1;
+    }
+
+    return (failedCount == 0) ? (0) : (1);
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,535 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#if !defined(__linux__)
+    #error Feature Extraction Daemon requires Linux (Unix domain sockets, memfd and SCM_RIGHTS)
+#endif
+
+#ifndef _GNU_SOURCE
+    #define _GNU_SOURCE
+#endif
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Library/Autotune.h"
+#include "Library/Daemon Protocol.h"
+#include "Library/Feature Extraction.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// +------------------------------------------------< TYPE >------------------------------------------------+
+
+struct DaemonConnection
+{
+    int      socket;
+    byte_t*  memory;
+    size_t   memorySize;
+    uint32_t queueDepth;
+    uint32_t pendingCount;
+    bool     closed;
+};
+
+struct DaemonBatch
+{
+    DaemonConnection*     connection;
+    uint32_t              count;
+    std::atomic<uint32_t> remaining;
+    DaemonRequest         requests[DAEMON_MAX_BATCH_SIZE];
+    DaemonResponse        responses[DAEMON_MAX_BATCH_SIZE];
+};
+
+struct DaemonJob
+{
+    DaemonBatch* batch;
+    uint32_t     index;
+};
+
+// +-----------------------------------------------< GLOBAL >-----------------------------------------------+
+
+static volatile sig_atomic_t stopRequested = 0;
+
+static std::mutex                jobMutex;
+static std::condition_variable   jobCondition;
+static std::deque<DaemonJob>     jobQueue;
+static bool                      workerStopping = false;
+
+static std::mutex                completionMutex;
+static std::vector<DaemonBatch*> completedBatches;
+static int                       completionEvent = -1;
+
+// +----------------------------------------------< REQUEST >-----------------------------------------------+
+
+static bool IsRequestInBounds(const DaemonConnection* connection, const DaemonRequest* request)
+{
+    if (request->operation >= DAEMON_OPERATION_COUNT || request->width <= 0 || request->height <= 0)
+        return false;
+
+    const uint64_t pixelCount = static_cast<uint64_t>(request->width) * static_cast<uint64_t>(request->height);
+
+    return request->inputOffset <= connection->memorySize && pixelCount <= connection->memorySize - request->inputOffset &&
+           request->outputOffset <= connection->memorySize && pixelCount <= connection->memorySize - request->outputOffset;
+}
+
+// Runs one request directly on the client's shared memory. scratch is the calling worker's buffer for the
+// intermediate image of a two-stage request, reused across requests; the operators themselves still allocate
+// their full-frame temporaries on every call, as the C API gives them no way to borrow a buffer.
+static int32_t ExecuteRequest(const DaemonConnection* connection, const DaemonRequest* request, std::vector<byte_t>& scratch)
+{
+    const uint8_t* inputImage  = connection->memory + request->inputOffset;
+    uint8_t*       outputImage = connection->memory + request->outputOffset;
+    const FESize   imageSize   = { request->width, request->height };
+    const FESize   wsize       = { request->wsize, request->wsize };
+
+    FEStatus status    = FE_STATUS_INVALID_ARGUMENT;
+    bool     threshold = request->parameter > 0.0;
+
+    switch (request->operation)
+    {
+    case DAEMON_SOBEL_EDGE:
+        status = FESobelEdge(inputImage, outputImage, imageSize);
+        break;
+    case DAEMON_HARRIS_CORNER:
+        status    = FEHarrisCorner(inputImage, outputImage, imageSize, request->wsize, request->parameter);
+        threshold = false;
+        break;
+    case DAEMON_DILATION_EDGE:
+        status = FEDilationEdge(inputImage, outputImage, imageSize, wsize);
+        break;
+    case DAEMON_EROSION_EDGE:
+        status = FEErosionEdge(inputImage, outputImage, imageSize, wsize);
+        break;
+    case DAEMON_UNBIAS_EDGE:
+        status    = FEUnbiasEdge(inputImage, outputImage, imageSize, wsize);
+        threshold = false;
+        break;
+    case DAEMON_UNBIAS_THRESHOLD_EDGE:
+        scratch.resize(static_cast<size_t>(request->width) * request->height);
+        status    = FEUnbiasEdge(inputImage, scratch.data(), imageSize, wsize);
+        status    = (status == FE_STATUS_OK) ? FELocalVarianceThreshold(inputImage, scratch.data(), outputImage, imageSize, wsize) : status;
+        threshold = false;
+        break;
+    case DAEMON_ENTROPY_SKETCH_EDGE:
+        status = FEEntropySketchEdge(inputImage, outputImage, imageSize, wsize);
+        break;
+    case DAEMON_DP_EDGE:
+        status = FEDPEdge(inputImage, outputImage, imageSize, wsize);
+        break;
+    case DAEMON_DIP_EDGE:
+        status = FEDIPEdge(inputImage, outputImage, imageSize, wsize);
+        break;
+    }
+
+    if (status == FE_STATUS_OK && threshold)
+    {
+        if (request->operation == DAEMON_ENTROPY_SKETCH_EDGE)
+            status = FEMinEdgeRatioThreshold(outputImage, outputImage, imageSize, request->parameter);
+        else
+            status = FEMaxEdgeRatioThreshold(outputImage, outputImage, imageSize, request->parameter);
+    }
+
+    return status;
+}
+
+static void CompleteBatch(DaemonBatch* batch)
+{
+    std::lock_guard<std::mutex> lock(completionMutex);
+
+    uint64_t signal = 1;
+
+    completedBatches.push_back(batch);
+
+    if (write(completionEvent, &signal, sizeof(signal)) != sizeof(signal))
+        perror("write");
+}
+
+// +-----------------------------------------------< WORKER >-----------------------------------------------+
+
+static void RunWorker(void)
+{
+    std::vector<byte_t> scratch;
+
+    for (;;)
+    {
+        DaemonJob job;
+
+        {
+            std::unique_lock<std::mutex> lock(jobMutex);
+
+            jobCondition.wait(lock, [] { return workerStopping || !jobQueue.empty(); });
+
+            if (jobQueue.empty())
+                return;
+
+            job = jobQueue.front();
+            jobQueue.pop_front();
+        }
+
+        DaemonBatch*         batch    = job.batch;
+        const DaemonRequest* request  = &batch->requests[job.index];
+        DaemonResponse*      response = &batch->responses[job.index];
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        response->status              = ExecuteRequest(batch->connection, request, scratch);
+        response->elapsedMicroseconds = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+
+        if (batch->remaining.fetch_sub(1) == 1)
+            CompleteBatch(batch);
+    }
+}
+
+// +---------------------------------------------< CONNECTION >---------------------------------------------+
+
+static void ReleaseConnection(DaemonConnection* connection)
+{
+    if (connection->memory != NULL)
+        munmap(connection->memory, connection->memorySize);
+
+    delete connection;
+}
+
+// The memfd must be sealed against shrinking, otherwise the client could truncate it under a running worker
+// and fault the daemon. Files that cannot be sealed, which are all but memfds, fail F_GET_SEALS and are refused.
+static int32_t AcceptHello(DaemonConnection* connection, const DaemonHello* hello, int memoryFile)
+{
+    struct stat status;
+
+    if (hello->magic != DAEMON_MAGIC || hello->version != DAEMON_VERSION || memoryFile < 0)
+        return DAEMON_STATUS_BAD_REQUEST;
+
+    const int seals = fcntl(memoryFile, F_GET_SEALS);
+
+    if (seals < 0 || (seals & F_SEAL_SHRINK) == 0 || fstat(memoryFile, &status) != 0 || status.st_size <= 0)
+        return DAEMON_STATUS_BAD_REQUEST;
+
+    void* memory = mmap(NULL, status.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, memoryFile, 0);
+
+    if (memory == MAP_FAILED)
+        return FE_STATUS_OUT_OF_MEMORY;
+
+    connection->memory     = static_cast<byte_t*>(memory);
+    connection->memorySize = static_cast<size_t>(status.st_size);
+    connection->queueDepth = std::min(std::max(hello->queueDepth, 1U), DAEMON_MAX_QUEUE_DEPTH);
+
+    return FE_STATUS_OK;
+}
+
+static void SendResponses(DaemonConnection* connection, const DaemonResponse* responses, uint32_t count)
+{
+    if (!connection->closed)
+        send(connection->socket, responses, sizeof(DaemonResponse) * count, MSG_NOSIGNAL);
+}
+
+// Admits a batch as a whole: if it would take the connection past its queue depth every request is answered
+// with DAEMON_STATUS_QUEUE_FULL, so a client never has to reconcile a partially accepted batch.
+static void AcceptBatch(DaemonConnection* connection, const DaemonBatchHeader* header, const DaemonRequest* requests)
+{
+    DaemonBatch* batch = new DaemonBatch;
+
+    batch->connection = connection;
+    batch->count      = header->count;
+    batch->remaining  = header->count;
+
+    memcpy(batch->requests, requests, sizeof(DaemonRequest) * header->count);
+
+    if (connection->pendingCount + header->count > connection->queueDepth)
+    {
+        for (uint32_t index = 0; index < header->count; ++index)
+            batch->responses[index] = { requests[index].tag, DAEMON_STATUS_QUEUE_FULL, 0 };
+
+        SendResponses(connection, batch->responses, batch->count);
+
+        delete batch;
+
+        return;
+    }
+
+    connection->pendingCount += header->count;
+
+    std::vector<DaemonJob> jobs;
+
+    for (uint32_t index = 0; index < header->count; ++index)
+    {
+        batch->responses[index] = { requests[index].tag, DAEMON_STATUS_BAD_REQUEST, 0 };
+
+        if (IsRequestInBounds(connection, &requests[index]))
+            jobs.push_back({ batch, index });
+        else
+            batch->remaining--;
+    }
+
+    if (jobs.empty())
+    {
+        CompleteBatch(batch);
+
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+
+        jobQueue.insert(jobQueue.end(), jobs.begin(), jobs.end());
+    }
+
+    jobCondition.notify_all();
+}
+
+// Returns false once the connection has to be closed.
+static bool ReceivePacket(DaemonConnection* connection)
+{
+    union
+    {
+        DaemonBatchHeader header;
+        byte_t            bytes[sizeof(DaemonBatchHeader) + sizeof(DaemonRequest) * DAEMON_MAX_BATCH_SIZE];
+    } packet;
+
+    char   control[CMSG_SPACE(sizeof(int))];
+    iovec  vector = { packet.bytes, sizeof(packet.bytes) };
+    msghdr message;
+
+    memset(&message, 0, sizeof(message));
+
+    message.msg_iov        = &vector;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+
+    ssize_t length     = recvmsg(connection->socket, &message, MSG_CMSG_CLOEXEC);
+    int     memoryFile = -1;
+
+    if (length <= 0)
+        return false;
+
+    for (cmsghdr* header = CMSG_FIRSTHDR(&message); header != NULL; header = CMSG_NXTHDR(&message, header))
+        if (header->cmsg_level == SOL_SOCKET && header->cmsg_type == SCM_RIGHTS)
+            memcpy(&memoryFile, CMSG_DATA(header), sizeof(int));
+
+    if (connection->memory == NULL)
+    {
+        DaemonHello      hello;
+        DaemonHelloReply reply = { DAEMON_STATUS_BAD_REQUEST, 0 };
+
+        if (length == sizeof(DaemonHello))
+        {
+            memcpy(&hello, packet.bytes, sizeof(hello));
+            reply.status = AcceptHello(connection, &hello, memoryFile);
+        }
+
+        if (memoryFile >= 0)
+            close(memoryFile);
+
+        reply.queueDepth = connection->queueDepth;
+
+        send(connection->socket, &reply, sizeof(reply), MSG_NOSIGNAL);
+
+        return reply.status == FE_STATUS_OK;
+    }
+
+    if (memoryFile >= 0)
+        close(memoryFile);
+
+    if (length < static_cast<ssize_t>(sizeof(DaemonBatchHeader)) || packet.header.count == 0 || packet.header.count > DAEMON_MAX_BATCH_SIZE ||
+        length != static_cast<ssize_t>(sizeof(DaemonBatchHeader) + sizeof(DaemonRequest) * packet.header.count))
+        return false;
+
+    AcceptBatch(connection, &packet.header, reinterpret_cast<const DaemonRequest*>(packet.bytes + sizeof(DaemonBatchHeader)));
+
+    return true;
+}
+
+// +-----------------------------------------------< EVENT >------------------------------------------------+
+
+static void DeliverCompletedBatches(void)
+{
+    std::vector<DaemonBatch*> batches;
+    uint64_t                  signal;
+
+    if (read(completionEvent, &signal, sizeof(signal)) != sizeof(signal))
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(completionMutex);
+
+        batches.swap(completedBatches);
+    }
+
+    for (size_t index = 0; index < batches.size(); ++index)
+    {
+        DaemonBatch*      batch      = batches[index];
+        DaemonConnection* connection = batch->connection;
+
+        SendResponses(connection, batch->responses, batch->count);
+
+        connection->pendingCount -= batch->count;
+
+        if (connection->closed && connection->pendingCount == 0)
+            ReleaseConnection(connection);
+
+        delete batch;
+    }
+}
+
+static void CloseConnection(DaemonConnection* connection)
+{
+    close(connection->socket);
+
+    connection->closed = true;
+
+    if (connection->pendingCount == 0)
+        ReleaseConnection(connection);
+}
+
+// The workers finish every queued request before they return, so afterwards every batch is completed.
+static void StopWorkers(std::vector<std::thread>& workers)
+{
+    {
+        std::lock_guard<std::mutex> lock(jobMutex);
+
+        workerStopping = true;
+    }
+
+    jobCondition.notify_all();
+
+    for (size_t thread = 0; thread < workers.size(); ++thread)
+        workers[thread].join();
+}
+
+// The stop signals are blocked except inside ppoll, so one arriving between two waits is still pending at the
+// next wait and interrupts it. On stopping, the requests already accepted are finished and answered before the
+// connections close, which releases every connection and batch.
+static void RunEventLoop(int listenSocket, std::vector<std::thread>& workers, const sigset_t* waitMask)
+{
+    std::vector<DaemonConnection*> connections;
+    std::vector<pollfd>            descriptors;
+
+    while (!stopRequested)
+    {
+        descriptors.clear();
+        descriptors.push_back({ listenSocket, POLLIN, 0 });
+        descriptors.push_back({ completionEvent, POLLIN, 0 });
+
+        for (size_t index = 0; index < connections.size(); ++index)
+            descriptors.push_back({ connections[index]->socket, POLLIN, 0 });
+
+        if (ppoll(descriptors.data(), descriptors.size(), NULL, waitMask) < 0)
+            continue;
+
+        if (descriptors[1].revents & POLLIN)
+            DeliverCompletedBatches();
+
+        for (size_t index = connections.size(); index-- > 0;)
+            if (descriptors[index + 2].revents != 0 && !ReceivePacket(connections[index]))
+            {
+                CloseConnection(connections[index]);
+                connections.erase(connections.begin() + index);
+            }
+
+        if (descriptors[0].revents & POLLIN)
+        {
+            int socket = accept4(listenSocket, NULL, NULL, SOCK_CLOEXEC);
+
+            if (socket >= 0)
+                connections.push_back(new DaemonConnection{ socket, NULL, 0, 0, 0, false });
+        }
+    }
+
+    StopWorkers(workers);
+    DeliverCompletedBatches();
+
+    for (size_t index = 0; index < connections.size(); ++index)
+        CloseConnection(connections[index]);
+}
+
+// +------------------------------------------------< MAIN >------------------------------------------------+
+
+static void HandleStopSignal(int)
+{
+    stopRequested = 1;
+}
+
+// Usage: "Feature Extraction Daemon" [socket path] [thread count]
+int main(int argc, char* argv[])
+{
+    const char* socketPath  = (argc > 1) ? argv[1] : DAEMON_SOCKET_PATH;
+    int         threadCount = (argc > 2) ? atoi(argv[2]) : 0;
+
+    LoadDefaultTuningProfile();
+
+    if (threadCount <= 0)
+        threadCount = SelectThreadCount();
+
+    struct sigaction action;
+    sigset_t         stopSignals;
+    sigset_t         waitMask;
+
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = HandleStopSignal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+
+    // Blocked before the workers start, so they inherit the mask and only the event loop's ppoll takes them.
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, &waitMask);
+
+    sockaddr_un address;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+
+    int listenSocket = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+
+    unlink(socketPath);
+
+    // The socket file is created owner-only, so only the daemon's user can connect to it.
+    const mode_t previousMask = umask(0077);
+    const bool   bound        = listenSocket >= 0 && bind(listenSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+
+    umask(previousMask);
+
+    if (!bound || listen(listenSocket, SOMAXCONN) != 0)
+    {
+        perror(socketPath);
+
+        return 1;
+    }
+
+    completionEvent = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+
+    std::vector<std::thread> workers;
+
+    for (int thread = 0; thread < threadCount; ++thread)
+        workers.push_back(std::thread(RunWorker));
+
+    RunEventLoop(listenSocket, workers, &waitMask);
+
+    close(listenSocket);
+    close(completionEvent);
+    unlink(socketPath);
+
+    return 0;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,319 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+    #define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Autotune.h"
+#include "Convolution.h"
+#include "Harris Corner Detector.h"
+#include "Sobel.h"
+#include "Structuring Element.h"
+#include "Utility.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// +-----------------------------------------------< TUNING >-----------------------------------------------+
+
+static const char* const DEFAULT_TUNING_PROFILE_FILE_NAME = "Feature Extraction.profile";
+static const char* const TUNING_PROFILE_VARIABLE          = "FE_TUNING_PROFILE";
+
+static TuningProfile& ActiveTuningProfile(void)
+{
+    static TuningProfile profile = CreateDefaultTuningProfile();
+
+    return profile;
+}
+
+// The defaults reproduce the behavior before tuning existed, so an untuned run is not slower than it was.
+TuningProfile CreateDefaultTuningProfile(void)
+{
+    TuningProfile profile;
+
+    for (int index = 0; index <= MAX_TUNED_WINDOW_SIZE / 2; ++index)
+        profile.windowVariant[index] = WINDOW_VARIANT_SCAN;
+
+    profile.sobelVariant          = CONVOLUTION_VARIANT_SEPARABLE;
+    profile.convolutionBandHeight = 32;
+    profile.threadCount           = 0;
+
+    return profile;
+}
+
+const TuningProfile* GetTuningProfile(void)
+{
+    return &ActiveTuningProfile();
+}
+
+// Not synchronized with running operators; set the profile at startup, before any processing.
+void SetTuningProfile(const TuningProfile* profile)
+{
+    assert(profile != NULL);
+    assert(profile->convolutionBandHeight > 0);
+
+    ActiveTuningProfile() = *profile;
+}
+
+// The profile is a text file of "key value" lines; keys missing from the file keep their default value and
+// unknown keys are ignored, so profiles written by older versions stay loadable.
+bool LoadTuningProfile(const char* fileName, TuningProfile* profile)
+{
+    assert(fileName != NULL);
+    assert(profile  != NULL);
+
+    FILE* fileStream = fopen(fileName, "r");
+
+    if (fileStream == NULL)
+        return false;
+
+    TuningProfile result = CreateDefaultTuningProfile();
+    char          line[256];
+    bool          valid  = true;
+
+    while (valid && fgets(line, sizeof(line), fileStream) != NULL)
+    {
+        char key[64];
+        char variant[64];
+        int  value;
+
+        if (line[0] == '#' || sscanf(line, "%63s", key) != 1)
+            continue;
+
+        if (strcmp(key, "window_variant") == 0)
+        {
+            valid = sscanf(line, "%*s %d %63s", &value, variant) == 2 && value >= 1 && value <= MAX_TUNED_WINDOW_SIZE && value % 2 == 1;
+
+            if (valid && strcmp(variant, "scan") == 0)
+                result.windowVariant[value / 2] = WINDOW_VARIANT_SCAN;
+            else if (valid && strcmp(variant, "running") == 0)
+                result.windowVariant[value / 2] = WINDOW_VARIANT_RUNNING;
+            else
+                valid = false;
+        }
+        else if (strcmp(key, "sobel_variant") == 0)
+        {
+            valid = sscanf(line, "%*s %63s", variant) == 1;
+
+            if (valid && strcmp(variant, "direct") == 0)
+                result.sobelVariant = CONVOLUTION_VARIANT_DIRECT;
+            else if (valid && strcmp(variant, "separable") == 0)
+                result.sobelVariant = CONVOLUTION_VARIANT_SEPARABLE;
+            else
+                valid = false;
+        }
+        else if (strcmp(key, "convolution_band_height") == 0)
+        {
+            valid = sscanf(line, "%*s %d", &value) == 1 && value > 0;
+
+            if (valid)
+                result.convolutionBandHeight = value;
+        }
+        else if (strcmp(key, "thread_count") == 0)
+        {
+            valid = sscanf(line, "%*s %d", &value) == 1 && value >= 0;
+
+            if (valid)
+                result.threadCount = value;
+        }
+    }
+
+    fclose(fileStream);
+
+    if (valid)
+        *profile = result;
+
+    return valid;
+}
+
+bool SaveTuningProfile(const char* fileName, const TuningProfile* profile)
+{
+    assert(fileName != NULL);
+    assert(profile  != NULL);
+
+    FILE* fileStream = fopen(fileName, "w");
+
+    if (fileStream == NULL)
+        return false;
+
+    fprintf(fileStream, "# Feature extraction tuning profile\n");
+    fprintf(fileStream, "sobel_variant %s\n", (profile->sobelVariant == CONVOLUTION_VARIANT_DIRECT) ? "direct" : "separable");
+    fprintf(fileStream, "convolution_band_height %d\n", profile->convolutionBandHeight);
+    fprintf(fileStream, "thread_count %d\n", profile->threadCount);
+
+    for (int size = 1; size <= MAX_TUNED_WINDOW_SIZE; size += 2)
+        fprintf(fileStream, "window_variant %d %s\n", size, (profile->windowVariant[size / 2] == WINDOW_VARIANT_RUNNING) ? "running" : "scan");
+
+    return fclose(fileStream) == 0;
+}
+
+// Loads the profile named by the FE_TUNING_PROFILE environment variable, or "Feature Extraction.profile" in
+// the working directory, and makes it active. Returns false, keeping the current profile, if there is none.
+bool LoadDefaultTuningProfile(void)
+{
+    const char*   fileName = getenv(TUNING_PROFILE_VARIABLE);
+    TuningProfile profile;
+
+    if (fileName == NULL || fileName[0] == '\0')
+        fileName = DEFAULT_TUNING_PROFILE_FILE_NAME;
+
+    if (!LoadTuningProfile(fileName, &profile))
+        return false;
+
+    SetTuningProfile(&profile);
+
+    return true;
+}
+
+int SelectWindowVariant(SIZE wsize)
+{
+    const int size = std::min<int>(std::max(wsize.cx, wsize.cy), MAX_TUNED_WINDOW_SIZE);
+
+    return GetTuningProfile()->windowVariant[size / 2];
+}
+
+int SelectThreadCount(void)
+{
+    if (GetTuningProfile()->threadCount > 0)
+        return GetTuningProfile()->threadCount;
+
+    return std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+}
+
+// +----------------------------------------------< AUTOTUNE >----------------------------------------------+
+
+template <typename function_t>
+static double MeasureBestTime(function_t function, const int repeatCount)
+{
+    double bestTime = 0.0;
+
+    for (int repeat = 0; repeat < repeatCount; ++repeat)
+    {
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        function();
+
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        if (repeat == 0 || time < bestTime)
+            bestTime = time;
+    }
+
+    return bestTime;
+}
+
+static void FillNoise(byte_t* image, size_t length, uint64_t state)
+{
+    for (size_t index = 0; index < length; ++index)
+    {
+        state        = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        image[index] = static_cast<byte_t>(state >> 56);
+    }
+}
+
+// Benchmarks every candidate on a synthetic imageSize frame and returns the fastest configuration; each
+// candidate is timed as the best of repeatCount runs. The active profile is switched while the convolution band
+// height is measured, so nothing else may run on the library meanwhile.
+TuningProfile TuneProfile(SIZE imageSize, const int repeatCount)
+{
+    assert(imageSize.cx > 2 * MAX_TUNED_WINDOW_SIZE && imageSize.cy > 2 * MAX_TUNED_WINDOW_SIZE);
+    assert(repeatCount > 0);
+
+    static const int BAND_HEIGHTS[]    = { 8, 16, 32, 64, 128 };
+    static const int MATCH_DESCRIPTORS = 2048;
+
+    const int           width    = imageSize.cx;
+    const int           height   = imageSize.cy;
+    const TuningProfile previous = *GetTuningProfile();
+
+    TuningProfile profile     = CreateDefaultTuningProfile();
+    byte_t*       inputImage  = new byte_t[width * height];
+    byte_t*       outputImage = new byte_t[width * height];
+    mag_t*        sobelImage  = new mag_t[width * height];
+    float*        floatImage  = new float[width * height];
+
+    FillNoise(inputImage, width * height, 0x9E3779B97F4A7C15ULL);
+
+    for (int size = 1; size <= MAX_TUNED_WINDOW_SIZE; size += 2)
+    {
+        const SIZE wsize = { size, size };
+
+        double scanTime = MeasureBestTime([&] {
+            for (int iy = size / 2; iy < height - size / 2; ++iy)
+                for (int ix = size / 2; ix < width - size / 2; ++ix)
+                    outputImage[iy * width + ix] = CalculateWindowMax(inputImage, imageSize, { ix, iy }, wsize);
+        }, repeatCount);
+
+        double runningTime = MeasureBestTime([&] {
+            StructuringElement element = CreateRectangleElement(wsize);
+
+            CalculateElementMax(inputImage, outputImage, imageSize, &element);
+        }, repeatCount);
+
+        profile.windowVariant[size / 2] = (runningTime < scanTime) ? WINDOW_VARIANT_RUNNING : WINDOW_VARIANT_SCAN;
+    }
+
+    double directTime    = MeasureBestTime([&] { Convolve(inputImage, sobelImage, imageSize, SelectSobelKernel(SOBEL_X, CONVOLUTION_VARIANT_DIRECT)); }, repeatCount);
+    double separableTime = MeasureBestTime([&] { Convolve(inputImage, sobelImage, imageSize, SelectSobelKernel(SOBEL_X, CONVOLUTION_VARIANT_SEPARABLE)); }, repeatCount);
+
+    profile.sobelVariant = (directTime < separableTime) ? CONVOLUTION_VARIANT_DIRECT : CONVOLUTION_VARIANT_SEPARABLE;
+
+    const ConvolutionKernel smoothingKernel = CreateGaussianKernel(2.0);
+    double                  bestBandTime    = 0.0;
+
+    for (size_t index = 0; index < sizeof(BAND_HEIGHTS) / sizeof(BAND_HEIGHTS[0]); ++index)
+    {
+        TuningProfile candidate = previous;
+
+        candidate.convolutionBandHeight = BAND_HEIGHTS[index];
+        SetTuningProfile(&candidate);
+
+        double bandTime = MeasureBestTime([&] { Convolve(inputImage, floatImage, imageSize, &smoothingKernel); }, repeatCount);
+
+        if (index == 0 || bandTime < bestBandTime)
+        {
+            bestBandTime                  = bandTime;
+            profile.convolutionBandHeight = BAND_HEIGHTS[index];
+        }
+    }
+
+    SetTuningProfile(&previous);
+
+    BinaryDescriptor* descriptors   = new BinaryDescriptor[MATCH_DESCRIPTORS * 2];
+    DescriptorMatch*  matches       = new DescriptorMatch[MATCH_DESCRIPTORS];
+    const int         hardwareCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    double            bestMatchTime = 0.0;
+
+    FillNoise(reinterpret_cast<byte_t*>(descriptors), sizeof(BinaryDescriptor) * MATCH_DESCRIPTORS * 2, 0xD1B54A32D192ED03ULL);
+
+    for (int threadCount = 1;; threadCount = std::min(threadCount * 2, hardwareCount))
+    {
+        double matchTime = MeasureBestTime([&] { MatchBinaryDescriptors(descriptors, MATCH_DESCRIPTORS, descriptors + MATCH_DESCRIPTORS, MATCH_DESCRIPTORS, matches, threadCount); }, repeatCount);
+
+        if (threadCount == 1 || matchTime < bestMatchTime)
+        {
+            bestMatchTime       = matchTime;
+            profile.threadCount = threadCount;
+        }
+
+        if (threadCount == hardwareCount)
+            break;
+    }
+
+    delete[] descriptors;
+    delete[] matches;
+
+    delete[] inputImage;
+    delete[] outputImage;
+    delete[] sobelImage;
+    delete[] floatImage;
+
+    return profile;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
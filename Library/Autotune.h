@@ -0,0 +1,51 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+// +-----------------------------------------------< TUNING >-----------------------------------------------+
+
+static const int MAX_TUNED_WINDOW_SIZE = 15;
+
+enum WindowVariant
+{
+    WINDOW_VARIANT_SCAN    = 0,
+    WINDOW_VARIANT_RUNNING = 1
+};
+
+enum ConvolutionVariant
+{
+    CONVOLUTION_VARIANT_DIRECT    = 0,
+    CONVOLUTION_VARIANT_SEPARABLE = 1
+};
+
+// The implementation choices that only affect speed, never results. windowVariant[size / 2] is the window
+// extremum strategy for square windows of the odd size (larger or non-square windows use the entry of their
+// larger side, clamped to MAX_TUNED_WINDOW_SIZE); threadCount 0 means one thread per hardware thread.
+struct TuningProfile
+{
+    int windowVariant[MAX_TUNED_WINDOW_SIZE / 2 + 1];
+    int sobelVariant;
+    int convolutionBandHeight;
+    int threadCount;
+};
+
+TuningProfile        CreateDefaultTuningProfile(void);
+const TuningProfile* GetTuningProfile(void);
+void                 SetTuningProfile(const TuningProfile* profile);
+
+bool                 LoadTuningProfile(const char* fileName, TuningProfile* profile);
+bool                 SaveTuningProfile(const char* fileName, const TuningProfile* profile);
+bool                 LoadDefaultTuningProfile(void);
+
+int                  SelectWindowVariant(SIZE wsize);
+int                  SelectThreadCount(void);
+
+// +----------------------------------------------< AUTOTUNE >----------------------------------------------+
+
+TuningProfile        TuneProfile(SIZE imageSize, const int repeatCount = 5);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
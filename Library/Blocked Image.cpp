@@ -0,0 +1,123 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Blocked Image.h"
+
+#include <cstring>
+
+// +-------------------------------------------< BLOCKED IMAGE >--------------------------------------------+
+
+BlockedImage* CreateBlockedImage(SIZE imageSize)
+{
+    assert(imageSize.cx > 0 && imageSize.cy > 0);
+
+    BlockedImage* image = new BlockedImage;
+
+    image->imageSize  = imageSize;
+    image->blockCount = { (imageSize.cx + IMAGE_BLOCK_SIZE - 1) / IMAGE_BLOCK_SIZE, (imageSize.cy + IMAGE_BLOCK_SIZE - 1) / IMAGE_BLOCK_SIZE };
+    image->blocks     = new byte_t[static_cast<size_t>(image->blockCount.cx) * image->blockCount.cy * IMAGE_BLOCK_PIXEL_COUNT];
+
+    return image;
+}
+
+void ReleaseBlockedImage(BlockedImage* image)
+{
+    if (image == NULL)
+        return;
+
+    delete[] image->blocks;
+    delete image;
+}
+
+// The pixels of the block inside the image, in image coordinates.
+RECT CalculateBlockRect(const BlockedImage* image, const int bx, const int by)
+{
+    assert(image != NULL);
+    assert(bx >= 0 && bx < image->blockCount.cx);
+    assert(by >= 0 && by < image->blockCount.cy);
+
+    RECT blockRect;
+
+    blockRect.left   = bx * IMAGE_BLOCK_SIZE;
+    blockRect.top    = by * IMAGE_BLOCK_SIZE;
+    blockRect.right  = std::min<LONG>((bx + 1) * IMAGE_BLOCK_SIZE, image->imageSize.cx);
+    blockRect.bottom = std::min<LONG>((by + 1) * IMAGE_BLOCK_SIZE, image->imageSize.cy);
+
+    return blockRect;
+}
+
+// Both conversions walk one band of blocks at a time, copying every block row as a single run, so each side is
+// read and written sequentially within a band of IMAGE_BLOCK_SIZE rows.
+BlockedImage* ConvertToBlockedImage(const byte_t* inputImage, BlockedImage* blockedImage)
+{
+    assert(inputImage   != NULL);
+    assert(blockedImage != NULL);
+
+    const int width = blockedImage->imageSize.cx;
+
+    for (int by = 0; by < blockedImage->blockCount.cy; ++by)
+        for (int bx = 0; bx < blockedImage->blockCount.cx; ++bx)
+        {
+            const RECT blockRect = CalculateBlockRect(blockedImage, bx, by);
+            const int  runLength = blockRect.right - blockRect.left;
+            byte_t*    block     = blockedImage->blocks + CalculateBlockOffset(blockedImage, bx, by);
+
+            if (runLength < IMAGE_BLOCK_SIZE || blockRect.bottom - blockRect.top < IMAGE_BLOCK_SIZE)
+                memset(block, 0, sizeof(byte_t) * IMAGE_BLOCK_PIXEL_COUNT);
+
+            for (int iy = blockRect.top; iy < blockRect.bottom; ++iy)
+                memcpy(block + (iy - blockRect.top) * IMAGE_BLOCK_SIZE, inputImage + static_cast<size_t>(iy) * width + blockRect.left, sizeof(byte_t) * runLength);
+        }
+
+    return blockedImage;
+}
+
+byte_t* ConvertFromBlockedImage(const BlockedImage* blockedImage, byte_t* outputImage)
+{
+    assert(blockedImage != NULL);
+    assert(outputImage  != NULL);
+
+    const int width = blockedImage->imageSize.cx;
+
+    for (int by = 0; by < blockedImage->blockCount.cy; ++by)
+        for (int bx = 0; bx < blockedImage->blockCount.cx; ++bx)
+        {
+            const RECT    blockRect = CalculateBlockRect(blockedImage, bx, by);
+            const int     runLength = blockRect.right - blockRect.left;
+            const byte_t* block     = blockedImage->blocks + CalculateBlockOffset(blockedImage, bx, by);
+
+            for (int iy = blockRect.top; iy < blockRect.bottom; ++iy)
+                memcpy(outputImage + static_cast<size_t>(iy) * width + blockRect.left, block + (iy - blockRect.top) * IMAGE_BLOCK_SIZE, sizeof(byte_t) * runLength);
+        }
+
+    return outputImage;
+}
+
+// Copies region, which must lie inside the image, into regionImage as a row-major image of the region's size.
+byte_t* GatherBlockedRegion(const BlockedImage* image, RECT region, byte_t* regionImage)
+{
+    assert(image       != NULL);
+    assert(regionImage != NULL);
+    assert(region.left >= 0 && region.right  <= image->imageSize.cx && region.left < region.right);
+    assert(region.top  >= 0 && region.bottom <= image->imageSize.cy && region.top  < region.bottom);
+
+    const int regionWidth = region.right - region.left;
+
+    for (int iy = region.top; iy < region.bottom; ++iy)
+    {
+        const int by = iy / IMAGE_BLOCK_SIZE;
+
+        for (int ix = region.left; ix < region.right;)
+        {
+            const int bx        = ix / IMAGE_BLOCK_SIZE;
+            const int runLength = std::min<int>((bx + 1) * IMAGE_BLOCK_SIZE, region.right) - ix;
+
+            memcpy(regionImage + (iy - region.top) * regionWidth + (ix - region.left), image->blocks + CalculateBlockOffset(image, bx, by) + (iy % IMAGE_BLOCK_SIZE) * IMAGE_BLOCK_SIZE + ix % IMAGE_BLOCK_SIZE, sizeof(byte_t) * runLength);
+
+            ix += runLength;
+        }
+    }
+
+    return regionImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,116 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+// +-------------------------------------------< BLOCKED IMAGE >--------------------------------------------+
+
+static const int IMAGE_BLOCK_SIZE        = 64;
+static const int IMAGE_BLOCK_PIXEL_COUNT = IMAGE_BLOCK_SIZE * IMAGE_BLOCK_SIZE;
+
+// The image is stored as IMAGE_BLOCK_SIZE square blocks, each one contiguous and row-major inside, in
+// row-major block order. Blocks on the right and bottom edges are padded to full size; the padding is zero
+// after conversion and otherwise unspecified. A 4 KB block is one page, so a window that crosses rows stays
+// within a few pages instead of touching one page per row as on a wide row-major image.
+struct BlockedImage
+{
+    SIZE    imageSize;
+    SIZE    blockCount;
+    byte_t* blocks;
+};
+
+inline size_t CalculateBlockOffset(const BlockedImage* image, const int bx, const int by)
+{
+    return (static_cast<size_t>(by) * image->blockCount.cx + bx) * IMAGE_BLOCK_PIXEL_COUNT;
+}
+
+BlockedImage* CreateBlockedImage(SIZE imageSize);
+void          ReleaseBlockedImage(BlockedImage* image);
+RECT          CalculateBlockRect(const BlockedImage* image, const int bx, const int by);
+
+BlockedImage* ConvertToBlockedImage(const byte_t* inputImage, BlockedImage* blockedImage);
+byte_t*       ConvertFromBlockedImage(const BlockedImage* blockedImage, byte_t* outputImage);
+byte_t*       GatherBlockedRegion(const BlockedImage* image, RECT region, byte_t* regionImage);
+
+// Calls function(bx, by, blockRect, window, windowRect) for every block in block order, where window holds the
+// pixels of windowRect, the block grown by halo and clipped to the image, as a contiguous row-major image.
+template <typename function_t>
+void ForEachImageBlock(const BlockedImage* image, SIZE halo, function_t function)
+{
+    assert(image != NULL);
+
+    byte_t* window = new byte_t[(IMAGE_BLOCK_SIZE + 2 * halo.cx) * (IMAGE_BLOCK_SIZE + 2 * halo.cy)];
+
+    for (int by = 0; by < image->blockCount.cy; ++by)
+        for (int bx = 0; bx < image->blockCount.cx; ++bx)
+        {
+            const RECT blockRect  = CalculateBlockRect(image, bx, by);
+            const RECT windowRect =
+            {
+                std::max<LONG>(blockRect.left - halo.cx, 0),
+                std::max<LONG>(blockRect.top - halo.cy, 0),
+                std::min<LONG>(blockRect.right + halo.cx, image->imageSize.cx),
+                std::min<LONG>(blockRect.bottom + halo.cy, image->imageSize.cy)
+            };
+
+            GatherBlockedRegion(image, windowRect, window);
+
+            function(bx, by, blockRect, static_cast<const byte_t*>(window), windowRect);
+        }
+
+    delete[] window;
+}
+
+// Normalization for values laid out like the blocks of outputImage; only pixels inside the image count
+// towards the minimum and maximum, so the result equals Normalization of the row-major values.
+template <typename value_t>
+BlockedImage* NormalizeBlockedImage(const value_t* blockValues, BlockedImage* outputImage)
+{
+    assert(blockValues != NULL);
+    assert(outputImage != NULL);
+
+    double maxValue = 0.0;
+    double minValue = 0.0;
+    bool   assigned = false;
+
+    for (int by = 0; by < outputImage->blockCount.cy; ++by)
+        for (int bx = 0; bx < outputImage->blockCount.cx; ++bx)
+        {
+            const RECT     blockRect = CalculateBlockRect(outputImage, bx, by);
+            const value_t* values    = blockValues + CalculateBlockOffset(outputImage, bx, by);
+
+            for (int iy = 0; iy < blockRect.bottom - blockRect.top; ++iy)
+                for (int ix = 0; ix < blockRect.right - blockRect.left; ++ix)
+                {
+                    const double value = static_cast<double>(values[iy * IMAGE_BLOCK_SIZE + ix]);
+
+                    maxValue = (!assigned || value > maxValue) ? (value) : (maxValue);
+                    minValue = (!assigned || value < minValue) ? (value) : (minValue);
+                    assigned = true;
+                }
+        }
+
+    for (int by = 0; by < outputImage->blockCount.cy; ++by)
+        for (int bx = 0; bx < outputImage->blockCount.cx; ++bx)
+        {
+            const RECT     blockRect = CalculateBlockRect(outputImage, bx, by);
+            const value_t* values    = blockValues + CalculateBlockOffset(outputImage, bx, by);
+            byte_t*        block     = outputImage->blocks + CalculateBlockOffset(outputImage, bx, by);
+
+            for (int iy = 0; iy < blockRect.bottom - blockRect.top; ++iy)
+                for (int ix = 0; ix < blockRect.right - blockRect.left; ++ix)
+                    block[iy * IMAGE_BLOCK_SIZE + ix] = NormalizeValue(values[iy * IMAGE_BLOCK_SIZE + ix], minValue, maxValue);
+        }
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,57 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+#ifndef NOMINMAX
+    #define NOMINMAX
+#endif
+
+#ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+#endif
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#if defined(_WIN32)
+    #include <Windows.h>
+#endif
+
+#include <cinttypes>
+
+// +------------------------------------------< TYPE DEFINITION >-------------------------------------------+
+
+typedef uint8_t  byte_t;
+typedef uint32_t lbyte_t;
+typedef int32_t  mag_t;
+
+// POINT, SIZE and RECT come from Windows.h on Windows; elsewhere the same layouts are declared here so the
+// library builds unchanged on the Linux hosts that embed it.
+#if !defined(_WIN32)
+typedef int32_t LONG;
+
+struct POINT
+{
+    LONG x;
+    LONG y;
+};
+
+struct SIZE
+{
+    LONG cx;
+    LONG cy;
+};
+
+struct RECT
+{
+    LONG left;
+    LONG top;
+    LONG right;
+    LONG bottom;
+};
+#endif
+
+// +----------------------------------------------< CONSTANT >----------------------------------------------+
+
+static const double PI = 3.14159265358979323846;
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,345 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Connected Component.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+// +----------------------------------------< CONNECTED COMPONENT >-----------------------------------------+
+
+static uint32_t FindLabelRoot(std::vector<uint32_t>& parents, uint32_t label)
+{
+    uint32_t root = label;
+
+    while (parents[root] != root)
+        root = parents[root];
+
+    while (parents[label] != root)
+    {
+        const uint32_t parent = parents[label];
+
+        parents[label] = root;
+        label          = parent;
+    }
+
+    return root;
+}
+
+// The smaller label becomes the root, so a root is always the label created first in its component and its
+// statistics start at the component's first pixel in raster order.
+static uint32_t UniteLabels(EdgeLabeler* labeler, const uint32_t label, const uint32_t otherLabel)
+{
+    const uint32_t root      = FindLabelRoot(labeler->parents, label);
+    const uint32_t otherRoot = FindLabelRoot(labeler->parents, otherLabel);
+
+    if (root == otherRoot)
+        return root;
+
+    const uint32_t       newRoot  = std::min(root, otherRoot);
+    const uint32_t       oldRoot  = std::max(root, otherRoot);
+    EdgeLabelStatistics& merged   = labeler->statistics[newRoot];
+    EdgeLabelStatistics& absorbed = labeler->statistics[oldRoot];
+
+    merged.pixelCount         += absorbed.pixelCount;
+    merged.sumX               += absorbed.sumX;
+    merged.sumY               += absorbed.sumY;
+    merged.boundingBox.left    = std::min(merged.boundingBox.left, absorbed.boundingBox.left);
+    merged.boundingBox.top     = std::min(merged.boundingBox.top, absorbed.boundingBox.top);
+    merged.boundingBox.right   = std::max(merged.boundingBox.right, absorbed.boundingBox.right);
+    merged.boundingBox.bottom  = std::max(merged.boundingBox.bottom, absorbed.boundingBox.bottom);
+
+    labeler->parents[oldRoot] = newRoot;
+
+    return newRoot;
+}
+
+EdgeLabeler* CreateEdgeLabeler(SIZE imageSize)
+{
+    EdgeLabeler* labeler = new EdgeLabeler;
+
+    labeler->imageSize      = imageSize;
+    labeler->rowCount       = 0;
+    labeler->previousLabels = new uint32_t[imageSize.cx];
+    labeler->currentLabels  = new uint32_t[imageSize.cx];
+
+    // Label 0 is the background.
+    labeler->parents.push_back(0);
+    labeler->statistics.push_back(EdgeLabelStatistics());
+
+    memset(labeler->currentLabels, 0, sizeof(uint32_t) * imageSize.cx);
+
+    return labeler;
+}
+
+void ReleaseEdgeLabeler(EdgeLabeler* labeler)
+{
+    assert(labeler != NULL);
+
+    delete[] labeler->previousLabels;
+    delete[] labeler->currentLabels;
+
+    delete labeler;
+}
+
+// rows holds rowCount rows of the image, continuing from the rows pushed before.
+void PushEdgeLabelerRows(EdgeLabeler* labeler, const byte_t* rows, const int rowCount)
+{
+    assert(labeler != NULL);
+    assert(rows    != NULL);
+    assert(labeler->rowCount + rowCount <= labeler->imageSize.cy);
+
+    const int width = labeler->imageSize.cx;
+
+    for (int row = 0; row < rowCount; ++row)
+    {
+        const int     iy    = labeler->rowCount++;
+        const byte_t* edges = rows + static_cast<size_t>(row) * width;
+
+        std::swap(labeler->previousLabels, labeler->currentLabels);
+
+        uint32_t*       labels      = labeler->currentLabels;
+        const uint32_t* upperLabels = labeler->previousLabels;
+
+        for (int ix = 0; ix < width; ++ix)
+        {
+            if (edges[ix] != EDGE_PIXEL_VALUE)
+            {
+                labels[ix] = 0;
+                continue;
+            }
+
+            const uint32_t neighbors[4] =
+            {
+                (ix > 0) ? (labels[ix - 1]) : (0),
+                (ix > 0) ? (upperLabels[ix - 1]) : (0),
+                upperLabels[ix],
+                (ix < width - 1) ? (upperLabels[ix + 1]) : (0)
+            };
+
+            uint32_t label = 0;
+
+            for (int neighbor = 0; neighbor < 4; ++neighbor)
+                if (neighbors[neighbor] != 0)
+                    label = (label == 0) ? (FindLabelRoot(labeler->parents, neighbors[neighbor])) : (UniteLabels(labeler, label, neighbors[neighbor]));
+
+            if (label == 0)
+            {
+                EdgeLabelStatistics statistics = { 0, { ix, iy, ix + 1, iy + 1 }, 0, 0, { ix, iy } };
+
+                label = static_cast<uint32_t>(labeler->parents.size());
+
+                labeler->parents.push_back(label);
+                labeler->statistics.push_back(statistics);
+            }
+
+            EdgeLabelStatistics& statistics = labeler->statistics[label];
+
+            statistics.pixelCount         += 1;
+            statistics.sumX               += ix;
+            statistics.sumY               += iy;
+            statistics.boundingBox.left    = std::min<LONG>(statistics.boundingBox.left, ix);
+            statistics.boundingBox.right   = std::max<LONG>(statistics.boundingBox.right, ix + 1);
+            statistics.boundingBox.bottom  = std::max<LONG>(statistics.boundingBox.bottom, iy + 1);
+
+            labels[ix] = label;
+        }
+    }
+}
+
+// The components are in the raster order of their first pixels.
+EdgeComponentSet* FinishEdgeLabeler(const EdgeLabeler* labeler)
+{
+    assert(labeler != NULL);
+
+    const uint32_t labelCount = static_cast<uint32_t>(labeler->parents.size());
+
+    EdgeComponentSet* componentSet = new EdgeComponentSet;
+
+    componentSet->imageSize      = labeler->imageSize;
+    componentSet->componentCount = 0;
+    componentSet->chainCodeCount = 0;
+    componentSet->chainCodes     = NULL;
+
+    for (uint32_t label = 1; label < labelCount; ++label)
+        if (labeler->parents[label] == label)
+            ++componentSet->componentCount;
+
+    componentSet->components = new EdgeComponent[componentSet->componentCount];
+
+    for (uint32_t label = 1, index = 0; label < labelCount; ++label)
+    {
+        if (labeler->parents[label] != label)
+            continue;
+
+        const EdgeLabelStatistics& statistics = labeler->statistics[label];
+        EdgeComponent&             component  = componentSet->components[index++];
+
+        component.pixelCount    = statistics.pixelCount;
+        component.boundingBox   = statistics.boundingBox;
+        component.centroidX     = static_cast<double>(statistics.sumX) / statistics.pixelCount;
+        component.centroidY     = static_cast<double>(statistics.sumY) / statistics.pixelCount;
+        component.start         = statistics.start;
+        component.contourOffset = 0;
+        component.contourLength = 0;
+    }
+
+    return componentSet;
+}
+
+EdgeComponentSet* LabelEdgeComponents(const byte_t* edgeImage, SIZE imageSize, const bool traceContours)
+{
+    assert(edgeImage != NULL);
+
+    EdgeLabeler* labeler = CreateEdgeLabeler(imageSize);
+
+    PushEdgeLabelerRows(labeler, edgeImage, imageSize.cy);
+
+    EdgeComponentSet* componentSet = FinishEdgeLabeler(labeler);
+
+    ReleaseEdgeLabeler(labeler);
+
+    return (traceContours) ? (TraceEdgeContours(componentSet, edgeImage)) : (componentSet);
+}
+
+// Streams one row of blocks at a time, so only a band of IMAGE_BLOCK_SIZE rows is ever row-major.
+EdgeComponentSet* LabelEdgeComponents(const BlockedImage* edgeImage, const bool traceContours)
+{
+    assert(edgeImage != NULL);
+
+    const SIZE imageSize = edgeImage->imageSize;
+
+    EdgeLabeler* labeler = CreateEdgeLabeler(imageSize);
+    byte_t*      band    = new byte_t[static_cast<size_t>(imageSize.cx) * IMAGE_BLOCK_SIZE];
+
+    for (int by = 0; by < edgeImage->blockCount.cy; ++by)
+    {
+        const RECT bandRect = { 0, by * IMAGE_BLOCK_SIZE, imageSize.cx, std::min(imageSize.cy, (by + 1) * IMAGE_BLOCK_SIZE) };
+
+        GatherBlockedRegion(edgeImage, bandRect, band);
+        PushEdgeLabelerRows(labeler, band, bandRect.bottom - bandRect.top);
+    }
+
+    delete[] band;
+
+    EdgeComponentSet* componentSet = FinishEdgeLabeler(labeler);
+
+    ReleaseEdgeLabeler(labeler);
+
+    return (traceContours) ? (TraceEdgeContours(componentSet, edgeImage)) : (componentSet);
+}
+
+// Moore neighbor tracing of the outer contour from the component's first pixel, whose west and northern
+// neighbors are all background. It stops on returning to the start about to repeat the first move, so thin
+// edges are walked out and back. isEdge(x, y) tests a pixel inside the image.
+template <typename EdgeTest>
+static void TraceEdgeContour(const EdgeComponent* component, SIZE imageSize, EdgeTest isEdge, std::vector<byte_t>& chainCodes)
+{
+    const size_t maxLength = chainCodes.size() + 8 * static_cast<size_t>(component->pixelCount);
+
+    POINT current   = component->start;
+    int   direction = 7;
+    int   firstCode = -1;
+
+    for (;;)
+    {
+        int code = -1;
+
+        // Search counter-clockwise, starting next to the background pixel the previous move left behind.
+        for (int turn = 0; turn < 8; ++turn)
+        {
+            const int candidate = (direction + ((direction % 2 == 0) ? (7) : (6)) + turn) % 8;
+            const int nx        = current.x + CHAIN_CODE_DX[candidate];
+            const int ny        = current.y + CHAIN_CODE_DY[candidate];
+
+            if (nx >= 0 && nx < imageSize.cx && ny >= 0 && ny < imageSize.cy && isEdge(nx, ny))
+            {
+                code = candidate;
+                break;
+            }
+        }
+
+        if (code < 0)
+            return;
+
+        if (current.x == component->start.x && current.y == component->start.y && code == firstCode)
+            return;
+
+        if (firstCode < 0)
+            firstCode = code;
+
+        chainCodes.push_back(static_cast<byte_t>(code));
+
+        current.x += CHAIN_CODE_DX[code];
+        current.y += CHAIN_CODE_DY[code];
+        direction  = code;
+
+        assert(chainCodes.size() <= maxLength);
+        (void)maxLength;
+    }
+}
+
+template <typename EdgeTest>
+static EdgeComponentSet* TraceEdgeContours(EdgeComponentSet* componentSet, EdgeTest isEdge)
+{
+    std::vector<byte_t> chainCodes;
+
+    for (uint32_t index = 0; index < componentSet->componentCount; ++index)
+    {
+        EdgeComponent& component = componentSet->components[index];
+
+        component.contourOffset = static_cast<uint32_t>(chainCodes.size());
+
+        TraceEdgeContour(&component, componentSet->imageSize, isEdge, chainCodes);
+
+        component.contourLength = static_cast<uint32_t>(chainCodes.size()) - component.contourOffset;
+    }
+
+    delete[] componentSet->chainCodes;
+
+    componentSet->chainCodeCount = static_cast<uint32_t>(chainCodes.size());
+    componentSet->chainCodes     = new byte_t[chainCodes.size()];
+
+    std::copy(chainCodes.begin(), chainCodes.end(), componentSet->chainCodes);
+
+    return componentSet;
+}
+
+// Only the pixels along each contour are read.
+EdgeComponentSet* TraceEdgeContours(EdgeComponentSet* componentSet, const byte_t* edgeImage)
+{
+    assert(componentSet != NULL);
+    assert(edgeImage    != NULL);
+
+    const int width = componentSet->imageSize.cx;
+
+    return TraceEdgeContours(componentSet, [&](int x, int y) {
+        return edgeImage[y * width + x] == EDGE_PIXEL_VALUE;
+    });
+}
+
+EdgeComponentSet* TraceEdgeContours(EdgeComponentSet* componentSet, const BlockedImage* edgeImage)
+{
+    assert(componentSet != NULL);
+    assert(edgeImage    != NULL);
+    assert(componentSet->imageSize.cx == edgeImage->imageSize.cx);
+    assert(componentSet->imageSize.cy == edgeImage->imageSize.cy);
+
+    return TraceEdgeContours(componentSet, [&](int x, int y) {
+        const byte_t* block = edgeImage->blocks + CalculateBlockOffset(edgeImage, x / IMAGE_BLOCK_SIZE, y / IMAGE_BLOCK_SIZE);
+
+        return block[(y % IMAGE_BLOCK_SIZE) * IMAGE_BLOCK_SIZE + x % IMAGE_BLOCK_SIZE] == EDGE_PIXEL_VALUE;
+    });
+}
+
+void ReleaseEdgeComponentSet(EdgeComponentSet* componentSet)
+{
+    assert(componentSet != NULL);
+
+    delete[] componentSet->components;
+    delete[] componentSet->chainCodes;
+
+    delete componentSet;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
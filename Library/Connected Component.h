@@ -0,0 +1,79 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Blocked Image.h"
+
+#include <cstddef>
+#include <vector>
+
+// +----------------------------------------< CONNECTED COMPONENT >-----------------------------------------+
+
+// Edge pixels are the ones set to 0 by the edge ratio thresholds and FindZeroCrossing; they are 8-connected.
+static const byte_t EDGE_PIXEL_VALUE = 0;
+
+// Freeman chain code directions, counter-clockwise from east with y pointing down.
+static const int CHAIN_CODE_DX[8] = { 1, 1, 0, -1, -1, -1, 0, 1 };
+static const int CHAIN_CODE_DY[8] = { 0, -1, -1, -1, 0, 1, 1, 1 };
+
+// The bounding box is exclusive on the right and bottom like a tile rect. start is the first pixel of the
+// component in raster order, where its contour begins; the contour is chainCodes[contourOffset] onwards for
+// contourLength codes, and empty for a single pixel or when no contours were traced.
+struct EdgeComponent
+{
+    uint32_t pixelCount;
+    RECT     boundingBox;
+    double   centroidX;
+    double   centroidY;
+    POINT    start;
+    uint32_t contourOffset;
+    uint32_t contourLength;
+};
+
+struct EdgeComponentSet
+{
+    SIZE           imageSize;
+    uint32_t       componentCount;
+    EdgeComponent* components;
+    uint32_t       chainCodeCount;
+    byte_t*        chainCodes;
+};
+
+struct EdgeLabelStatistics
+{
+    uint32_t pixelCount;
+    RECT     boundingBox;
+    uint64_t sumX;
+    uint64_t sumY;
+    POINT    start;
+};
+
+// Labels an edge image fed a band of rows at a time, keeping only the labels of the last row: provisional
+// labels are merged with union-find and their statistics are merged along with them, so the bands can come
+// straight from an operator's output without the frame ever being assembled.
+struct EdgeLabeler
+{
+    SIZE      imageSize;
+    int       rowCount;
+    uint32_t* previousLabels;
+    uint32_t* currentLabels;
+
+    std::vector<uint32_t>            parents;
+    std::vector<EdgeLabelStatistics> statistics;
+};
+
+EdgeLabeler*      CreateEdgeLabeler(SIZE imageSize);
+void              ReleaseEdgeLabeler(EdgeLabeler* labeler);
+void              PushEdgeLabelerRows(EdgeLabeler* labeler, const byte_t* rows, const int rowCount);
+EdgeComponentSet* FinishEdgeLabeler(const EdgeLabeler* labeler);
+
+EdgeComponentSet* LabelEdgeComponents(const byte_t* edgeImage, SIZE imageSize, const bool traceContours = false);
+EdgeComponentSet* LabelEdgeComponents(const BlockedImage* edgeImage, const bool traceContours = false);
+EdgeComponentSet* TraceEdgeContours(EdgeComponentSet* componentSet, const byte_t* edgeImage);
+EdgeComponentSet* TraceEdgeContours(EdgeComponentSet* componentSet, const BlockedImage* edgeImage);
+void              ReleaseEdgeComponentSet(EdgeComponentSet* componentSet);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
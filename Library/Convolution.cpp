@@ -0,0 +1,443 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Convolution.h"
+
+#include <cmath>
+#include <cstdlib>
+
+// +--------------------------------------------< CONVOLUTION >---------------------------------------------+
+
+long long CalculateGreatestCommonDivisor(long long a, long long b)
+{
+    a = llabs(a);
+    b = llabs(b);
+
+    while (b != 0)
+    {
+        long long remainder = a % b;
+
+        a = b;
+        b = remainder;
+    }
+
+    return a;
+}
+
+bool FactorizeIntegralKernel(ConvolutionKernel* kernel)
+{
+    assert(kernel != NULL);
+    assert(kernel->integral);
+
+    const int kw = kernel->ksize.cx;
+    const int kh = kernel->ksize.cy;
+
+    int pivotRow    = -1;
+    int pivotColumn = -1;
+
+    for (int ky = 0; ky < kh && pivotRow < 0; ++ky)
+        for (int kx = 0; kx < kw; ++kx)
+            if (kernel->weights[ky * kw + kx] != 0.0)
+            {
+                pivotRow = ky;
+                break;
+            }
+
+    if (pivotRow < 0)
+        return false;
+
+    long long divisor = 0;
+
+    for (int kx = 0; kx < kw; ++kx)
+        divisor = CalculateGreatestCommonDivisor(divisor, llround(kernel->weights[pivotRow * kw + kx]));
+
+    for (int kx = 0; kx < kw; ++kx)
+    {
+        kernel->rowFactors[0][kx] = static_cast<double>(llround(kernel->weights[pivotRow * kw + kx]) / divisor);
+
+        if (pivotColumn < 0 && kernel->rowFactors[0][kx] != 0.0)
+            pivotColumn = kx;
+    }
+
+    for (int ky = 0; ky < kh; ++ky)
+    {
+        long long weight = llround(kernel->weights[ky * kw + pivotColumn]);
+        long long factor = llround(kernel->rowFactors[0][pivotColumn]);
+
+        if (weight % factor != 0)
+            return false;
+
+        kernel->columnFactors[0][ky] = static_cast<double>(weight / factor);
+    }
+
+    for (int ky = 0; ky < kh; ++ky)
+        for (int kx = 0; kx < kw; ++kx)
+            if (kernel->columnFactors[0][ky] * kernel->rowFactors[0][kx] != kernel->weights[ky * kw + kx])
+                return false;
+
+    return true;
+}
+
+// Cyclic Jacobi eigen decomposition of a symmetric size x size matrix. On return the diagonal of matrix holds
+// the eigenvalues and the columns of eigenvectors the corresponding eigenvectors.
+void CalculateSymmetricEigen(double* matrix, double* eigenvectors, const int size)
+{
+    assert(matrix       != NULL);
+    assert(eigenvectors != NULL);
+
+    for (int row = 0; row < size; ++row)
+        for (int column = 0; column < size; ++column)
+            eigenvectors[row * size + column] = (row == column) ? (1.0) : (0.0);
+
+    for (int sweep = 0; sweep < 100; ++sweep)
+    {
+        double offDiagonal = 0.0;
+
+        for (int p = 0; p < size; ++p)
+            for (int q = p + 1; q < size; ++q)
+                offDiagonal += matrix[p * size + q] * matrix[p * size + q];
+
+        if (offDiagonal < 1e-30)
+            break;
+
+        for (int p = 0; p < size; ++p)
+            for (int q = p + 1; q < size; ++q)
+            {
+                if (fabs(matrix[p * size + q]) < 1e-300)
+                    continue;
+
+                double theta   = (matrix[q * size + q] - matrix[p * size + p]) / (2.0 * matrix[p * size + q]);
+                double tangent = ((theta >= 0.0) ? (1.0) : (-1.0)) / (fabs(theta) + sqrt(theta * theta + 1.0));
+                double cosine  = 1.0 / sqrt(tangent * tangent + 1.0);
+                double sine    = tangent * cosine;
+
+                for (int k = 0; k < size; ++k)
+                {
+                    double kp = matrix[k * size + p];
+                    double kq = matrix[k * size + q];
+
+                    matrix[k * size + p] = cosine * kp - sine * kq;
+                    matrix[k * size + q] = sine * kp + cosine * kq;
+                }
+
+                for (int k = 0; k < size; ++k)
+                {
+                    double pk = matrix[p * size + k];
+                    double qk = matrix[q * size + k];
+
+                    matrix[p * size + k] = cosine * pk - sine * qk;
+                    matrix[q * size + k] = sine * pk + cosine * qk;
+                }
+
+                for (int k = 0; k < size; ++k)
+                {
+                    double kp = eigenvectors[k * size + p];
+                    double kq = eigenvectors[k * size + q];
+
+                    eigenvectors[k * size + p] = cosine * kp - sine * kq;
+                    eigenvectors[k * size + q] = sine * kp + cosine * kq;
+                }
+            }
+    }
+}
+
+// Low-rank factorization from the singular value decomposition K = sum(s * u * v^T): the eigenvectors v of
+// K^T K are the row factors and K * v = s * u the column factors. The smallest rank reproducing the kernel is
+// kept, and only when rank * (kw + kh) multiplications beat the kw * kh of the direct evaluation.
+void FactorizeFloatKernel(ConvolutionKernel* kernel)
+{
+    assert(kernel != NULL);
+
+    const int kw = kernel->ksize.cx;
+    const int kh = kernel->ksize.cy;
+
+    double* gram         = new double[kw * kw];
+    double* eigenvectors = new double[kw * kw];
+    double* residual     = new double[kw * kh];
+    int*    order        = new int[kw];
+    double  maxWeight    = 0.0;
+
+    for (int p = 0; p < kw; ++p)
+        for (int q = 0; q < kw; ++q)
+        {
+            gram[p * kw + q] = 0.0;
+
+            for (int ky = 0; ky < kh; ++ky)
+                gram[p * kw + q] += kernel->weights[ky * kw + p] * kernel->weights[ky * kw + q];
+        }
+
+    CalculateSymmetricEigen(gram, eigenvectors, kw);
+
+    for (int index = 0; index < kw; ++index)
+        order[index] = index;
+
+    std::sort(order, order + kw, [&](int a, int b) { return gram[a * kw + a] > gram[b * kw + b]; });
+
+    for (int index = 0; index < kw * kh; ++index)
+    {
+        residual[index] = kernel->weights[index];
+        maxWeight       = std::max(maxWeight, fabs(kernel->weights[index]));
+    }
+
+    kernel->rank = 0;
+
+    for (int term = 0; term < std::min(kw, kh) && maxWeight > 0.0; ++term)
+    {
+        double maxResidual = 0.0;
+
+        for (int kx = 0; kx < kw; ++kx)
+            kernel->rowFactors[term][kx] = eigenvectors[kx * kw + order[term]];
+
+        for (int ky = 0; ky < kh; ++ky)
+        {
+            kernel->columnFactors[term][ky] = 0.0;
+
+            for (int kx = 0; kx < kw; ++kx)
+                kernel->columnFactors[term][ky] += kernel->weights[ky * kw + kx] * kernel->rowFactors[term][kx];
+        }
+
+        for (int ky = 0; ky < kh; ++ky)
+            for (int kx = 0; kx < kw; ++kx)
+            {
+                residual[ky * kw + kx] -= kernel->columnFactors[term][ky] * kernel->rowFactors[term][kx];
+                maxResidual             = std::max(maxResidual, fabs(residual[ky * kw + kx]));
+            }
+
+        if (maxResidual <= 1e-6 * maxWeight)
+        {
+            kernel->rank = term + 1;
+            break;
+        }
+    }
+
+    if (kernel->rank * (kw + kh) >= kw * kh)
+        kernel->rank = 0;
+
+    delete[] gram;
+    delete[] eigenvectors;
+    delete[] residual;
+    delete[] order;
+}
+
+ConvolutionKernel CreateConvolutionKernel(const double* weights, SIZE ksize)
+{
+    assert(weights != NULL);
+    assert(ksize.cx % 2 == 1 && ksize.cx <= MAX_KERNEL_SIZE);
+    assert(ksize.cy % 2 == 1 && ksize.cy <= MAX_KERNEL_SIZE);
+
+    ConvolutionKernel kernel;
+
+    kernel.ksize    = ksize;
+    kernel.integral = true;
+    kernel.rank     = 0;
+
+    for (int index = 0; index < ksize.cx * ksize.cy; ++index)
+    {
+        kernel.weights[index] = weights[index];
+
+        if (weights[index] != floor(weights[index]))
+            kernel.integral = false;
+    }
+
+    if (kernel.integral)
+        kernel.rank = FactorizeIntegralKernel(&kernel) ? (1) : (0);
+    else
+        FactorizeFloatKernel(&kernel);
+
+    return kernel;
+}
+
+ConvolutionKernel CreateSobelKernel(const int direction)
+{
+    assert(direction == SOBEL_X || direction == SOBEL_Y);
+
+    static const double SOBEL_MASK_X[9] = { -1,  0,  1, -2,  0,  2, -1,  0,  1 };
+    static const double SOBEL_MASK_Y[9] = { -1, -2, -1,  0,  0,  0,  1,  2,  1 };
+
+    return CreateConvolutionKernel(direction ? SOBEL_MASK_Y : SOBEL_MASK_X, { 3, 3 });
+}
+
+ConvolutionKernel CreateScharrKernel(const int direction)
+{
+    assert(direction == SOBEL_X || direction == SOBEL_Y);
+
+    static const double SCHARR_MASK_X[9] = {  -3,   0,  3, -10,  0, 10, -3, 0, 3 };
+    static const double SCHARR_MASK_Y[9] = {  -3, -10, -3,   0,  0,  0,  3, 10, 3 };
+
+    return CreateConvolutionKernel(direction ? SCHARR_MASK_Y : SCHARR_MASK_X, { 3, 3 });
+}
+
+ConvolutionKernel CreatePrewittKernel(const int direction)
+{
+    assert(direction == SOBEL_X || direction == SOBEL_Y);
+
+    static const double PREWITT_MASK_X[9] = { -1,  0,  1, -1,  0,  1, -1,  0,  1 };
+    static const double PREWITT_MASK_Y[9] = { -1, -1, -1,  0,  0,  0,  1,  1,  1 };
+
+    return CreateConvolutionKernel(direction ? PREWITT_MASK_Y : PREWITT_MASK_X, { 3, 3 });
+}
+
+ConvolutionKernel CreateGaussianKernel(const double sigma)
+{
+    assert(sigma > 0.0);
+
+    const int radius = std::min(static_cast<int>(ceil(3.0 * sigma)), MAX_KERNEL_SIZE / 2);
+    const int size   = 2 * radius + 1;
+
+    double weights[MAX_KERNEL_SIZE * MAX_KERNEL_SIZE];
+    double weightSum = 0.0;
+
+    for (int ky = -radius; ky <= radius; ++ky)
+        for (int kx = -radius; kx <= radius; ++kx)
+        {
+            weights[(ky + radius) * size + (kx + radius)] = exp(-(kx * kx + ky * ky) / (2.0 * sigma * sigma));
+            weightSum += weights[(ky + radius) * size + (kx + radius)];
+        }
+
+    for (int index = 0; index < size * size; ++index)
+        weights[index] /= weightSum;
+
+    return CreateConvolutionKernel(weights, { size, size });
+}
+
+ConvolutionKernel CreateLaplacianOfGaussianKernel(const double sigma)
+{
+    assert(sigma > 0.0);
+
+    const int radius = std::min(static_cast<int>(ceil(3.0 * sigma)), MAX_KERNEL_SIZE / 2);
+    const int size   = 2 * radius + 1;
+
+    double weights[MAX_KERNEL_SIZE * MAX_KERNEL_SIZE];
+    double weightMean = 0.0;
+
+    for (int ky = -radius; ky <= radius; ++ky)
+        for (int kx = -radius; kx <= radius; ++kx)
+        {
+            double distance = (kx * kx + ky * ky) / (2.0 * sigma * sigma);
+
+            weights[(ky + radius) * size + (kx + radius)] = (distance - 1.0) * exp(-distance) / (PI * pow(sigma, 4));
+            weightMean += weights[(ky + radius) * size + (kx + radius)];
+        }
+
+    weightMean /= size * size;
+
+    for (int index = 0; index < size * size; ++index)
+        weights[index] -= weightMean;
+
+    return CreateConvolutionKernel(weights, { size, size });
+}
+
+// +-----------------------------------------< RECURSIVE GAUSSIAN >-----------------------------------------+
+
+RecursiveGaussian CreateRecursiveGaussian(const double sigma)
+{
+    assert(sigma >= 0.5);
+
+    const double q  = (sigma >= 2.5) ? (0.98711 * sigma - 0.96330) : (3.97156 - 4.14554 * sqrt(1.0 - 0.26891 * sigma));
+    const double b0 = 1.57825 + 2.44413 * q + 1.4281 * q * q + 0.422205 * q * q * q;
+    const double b1 = 2.44413 * q + 2.85619 * q * q + 1.26661 * q * q * q;
+    const double b2 = -(1.4281 * q * q + 1.26661 * q * q * q);
+    const double b3 = 0.422205 * q * q * q;
+
+    RecursiveGaussian filter;
+
+    filter.sigma       = sigma;
+    filter.gain        = static_cast<float>(1.0 - (b1 + b2 + b3) / b0);
+    filter.feedback[0] = static_cast<float>(b1 / b0);
+    filter.feedback[1] = static_cast<float>(b2 / b0);
+    filter.feedback[2] = static_cast<float>(b3 / b0);
+
+    return filter;
+}
+
+// Filters values in place. Both passes start from the steady state of the edge sample, which extends the
+// signal by replication.
+float* FilterRecursiveGaussianRow(const RecursiveGaussian* filter, float* values, const int length)
+{
+    assert(filter != NULL);
+    assert(values != NULL);
+    assert(length > 0);
+
+    const float gain = filter->gain;
+    const float a1   = filter->feedback[0];
+    const float a2   = filter->feedback[1];
+    const float a3   = filter->feedback[2];
+
+    float w1 = values[0];
+    float w2 = values[0];
+    float w3 = values[0];
+
+    for (int index = 0; index < length; ++index)
+    {
+        const float w0 = gain * values[index] + a1 * w1 + a2 * w2 + a3 * w3;
+
+        values[index] = w0;
+        w3            = w2;
+        w2            = w1;
+        w1            = w0;
+    }
+
+    w1 = values[length - 1];
+    w2 = values[length - 1];
+    w3 = values[length - 1];
+
+    for (int index = length - 1; index >= 0; --index)
+    {
+        const float w0 = gain * values[index] + a1 * w1 + a2 * w2 + a3 * w3;
+
+        values[index] = w0;
+        w3            = w2;
+        w2            = w1;
+        w1            = w0;
+    }
+
+    return values;
+}
+
+// The column passes run a row at a time over every column, so each step reads whole rows that the compiler
+// vectorizes, and need only the three rows of edge state beyond the image.
+float* FilterRecursiveGaussianColumns(const RecursiveGaussian* filter, float* image, SIZE imageSize)
+{
+    assert(filter != NULL);
+    assert(image  != NULL);
+
+    const int   width  = imageSize.cx;
+    const int   height = imageSize.cy;
+    const float gain   = filter->gain;
+    const float a1     = filter->feedback[0];
+    const float a2     = filter->feedback[1];
+    const float a3     = filter->feedback[2];
+
+    float* edgeRow = new float[width];
+
+    memcpy(edgeRow, image, sizeof(float) * width);
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        float*       row  = image + static_cast<size_t>(iy) * width;
+        const float* row1 = (iy >= 1) ? (row - width) : (edgeRow);
+        const float* row2 = (iy >= 2) ? (row - 2 * width) : (edgeRow);
+        const float* row3 = (iy >= 3) ? (row - 3 * width) : (edgeRow);
+
+        for (int ix = 0; ix < width; ++ix)
+            row[ix] = gain * row[ix] + a1 * row1[ix] + a2 * row2[ix] + a3 * row3[ix];
+    }
+
+    memcpy(edgeRow, image + static_cast<size_t>(height - 1) * width, sizeof(float) * width);
+
+    for (int iy = height - 1; iy >= 0; --iy)
+    {
+        float*       row  = image + static_cast<size_t>(iy) * width;
+        const float* row1 = (iy < height - 1) ? (row + width) : (edgeRow);
+        const float* row2 = (iy < height - 2) ? (row + 2 * width) : (edgeRow);
+        const float* row3 = (iy < height - 3) ? (row + 3 * width) : (edgeRow);
+
+        for (int ix = 0; ix < width; ++ix)
+            row[ix] = gain * row[ix] + a1 * row1[ix] + a2 * row2[ix] + a3 * row3[ix];
+    }
+
+    delete[] edgeRow;
+
+    return image;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,227 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Autotune.h"
+#include "Image Source.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+
+// +------------------------------------------< SOBEL DIRECTION >-------------------------------------------+
+
+#define SOBEL_X 0
+#define SOBEL_Y 1
+
+// +--------------------------------------------< CONVOLUTION >---------------------------------------------+
+
+static const int MAX_KERNEL_SIZE = 31;
+
+// Weights are applied as a correlation, weights[ky * ksize.cx + kx] multiplying the pixel at offset
+// (kx - ksize.cx / 2, ky - ksize.cy / 2). rank is the number of separable column x row terms the kernel was
+// factorized into, 0 meaning it is evaluated directly. Integral kernels are only factorized when an exact
+// integer rank-1 factorization exists, so their results stay bit-exact.
+struct ConvolutionKernel
+{
+    SIZE   ksize;
+    bool   integral;
+    double weights[MAX_KERNEL_SIZE * MAX_KERNEL_SIZE];
+
+    int    rank;
+    double columnFactors[MAX_KERNEL_SIZE][MAX_KERNEL_SIZE];
+    double rowFactors[MAX_KERNEL_SIZE][MAX_KERNEL_SIZE];
+};
+
+long long         CalculateGreatestCommonDivisor(long long a, long long b);
+
+ConvolutionKernel CreateConvolutionKernel(const double* weights, SIZE ksize);
+ConvolutionKernel CreateSobelKernel(const int direction);
+ConvolutionKernel CreateScharrKernel(const int direction);
+ConvolutionKernel CreatePrewittKernel(const int direction);
+ConvolutionKernel CreateGaussianKernel(const double sigma);
+ConvolutionKernel CreateLaplacianOfGaussianKernel(const double sigma);
+
+// Evaluates the kernel for the pixels of region that have a full kernel window, leaving the rest of
+// outputImage untouched. The region is processed in bands of the tuned convolutionBandHeight rows so that
+// the row pass results of a band stay in cache for its column pass; every inner loop runs over contiguous
+// pixels of a row with one weight, which the compiler vectorizes. The input rows come from readRow(iy), which
+// returns the first pixel of row iy; every row is read once per band and term by the separable passes and kh
+// times, in order, by the direct one.
+template <typename value_t, typename RowFunction>
+value_t* ConvolveRegionRows(RowFunction readRow, value_t* outputImage, SIZE imageSize, const ConvolutionKernel* kernel, RECT region)
+{
+    assert(outputImage != NULL);
+    assert(kernel      != NULL);
+    assert(kernel->integral || !std::numeric_limits<value_t>::is_integer);
+
+    const int width      = imageSize.cx;
+    const int height     = imageSize.cy;
+    const int kw         = kernel->ksize.cx;
+    const int kh         = kernel->ksize.cy;
+    const int bandHeight = GetTuningProfile()->convolutionBandHeight;
+
+    region.left   = std::max<LONG>(region.left, kw / 2);
+    region.top    = std::max<LONG>(region.top, kh / 2);
+    region.right  = std::min<LONG>(region.right, width - kw / 2);
+    region.bottom = std::min<LONG>(region.bottom, height - kh / 2);
+
+    if (region.left >= region.right || region.top >= region.bottom)
+        return outputImage;
+
+    const int regionWidth = region.right - region.left;
+
+    value_t* rowImage    = new value_t[(bandHeight + kh - 1) * regionWidth];
+    value_t* accumulator = new value_t[regionWidth];
+
+    for (int bandTop = region.top; bandTop < region.bottom; bandTop += bandHeight)
+    {
+        const int bandBottom = std::min<int>(bandTop + bandHeight, region.bottom);
+
+        if (kernel->rank == 0)
+        {
+            for (int iy = bandTop; iy < bandBottom; ++iy)
+            {
+                memset(accumulator, 0, sizeof(value_t) * regionWidth);
+
+                for (int ky = 0; ky < kh; ++ky)
+                    for (int kx = 0; kx < kw; ++kx)
+                    {
+                        const value_t weight = static_cast<value_t>(kernel->weights[ky * kw + kx]);
+                        const byte_t* source = readRow(iy + ky - kh / 2) + (region.left + kx - kw / 2);
+
+                        if (weight == 0)
+                            continue;
+
+                        for (int ix = 0; ix < regionWidth; ++ix)
+                            accumulator[ix] += weight * source[ix];
+                    }
+
+                memcpy(outputImage + iy * width + region.left, accumulator, sizeof(value_t) * regionWidth);
+            }
+
+            continue;
+        }
+
+        for (int term = 0; term < kernel->rank; ++term)
+        {
+            for (int iy = bandTop - kh / 2; iy < bandBottom + kh / 2; ++iy)
+            {
+                value_t* rowValues = rowImage + (iy - bandTop + kh / 2) * regionWidth;
+
+                memset(rowValues, 0, sizeof(value_t) * regionWidth);
+
+                for (int kx = 0; kx < kw; ++kx)
+                {
+                    const value_t weight = static_cast<value_t>(kernel->rowFactors[term][kx]);
+                    const byte_t* source = readRow(iy) + (region.left + kx - kw / 2);
+
+                    if (weight == 0)
+                        continue;
+
+                    for (int ix = 0; ix < regionWidth; ++ix)
+                        rowValues[ix] += weight * source[ix];
+                }
+            }
+
+            for (int iy = bandTop; iy < bandBottom; ++iy)
+            {
+                value_t* outputRow = outputImage + iy * width + region.left;
+
+                memset(accumulator, 0, sizeof(value_t) * regionWidth);
+
+                for (int ky = 0; ky < kh; ++ky)
+                {
+                    const value_t  weight    = static_cast<value_t>(kernel->columnFactors[term][ky]);
+                    const value_t* rowValues = rowImage + (iy - bandTop + ky) * regionWidth;
+
+                    if (weight == 0)
+                        continue;
+
+                    for (int ix = 0; ix < regionWidth; ++ix)
+                        accumulator[ix] += weight * rowValues[ix];
+                }
+
+                if (term == 0)
+                    memcpy(outputRow, accumulator, sizeof(value_t) * regionWidth);
+                else
+                    for (int ix = 0; ix < regionWidth; ++ix)
+                        outputRow[ix] += accumulator[ix];
+            }
+        }
+    }
+
+    delete[] rowImage;
+    delete[] accumulator;
+
+    return outputImage;
+}
+
+template <typename value_t>
+value_t* ConvolveRegion(const byte_t* inputImage, value_t* outputImage, SIZE imageSize, const ConvolutionKernel* kernel, RECT region)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(kernel      != NULL);
+
+    const int width = imageSize.cx;
+
+    return ConvolveRegionRows([&](int iy) { return inputImage + iy * width; }, outputImage, imageSize, kernel, region);
+}
+
+template <typename value_t>
+value_t* Convolve(const byte_t* inputImage, value_t* outputImage, SIZE imageSize, const ConvolutionKernel* kernel)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(kernel      != NULL);
+
+    memset(outputImage, 0, sizeof(value_t) * imageSize.cx * imageSize.cy);
+
+    return ConvolveRegion(inputImage, outputImage, imageSize, kernel, { 0, 0, imageSize.cx, imageSize.cy });
+}
+
+// Convolution of a camera frame without a packed gray copy: planar luma rows are read in place with the
+// source stride, and RGB rows are converted as the row pass first reaches them, into a ring covering a band
+// and its kernel rows.
+template <typename value_t>
+value_t* Convolve(const ImageSource* source, value_t* outputImage, const ConvolutionKernel* kernel)
+{
+    assert(source      != NULL);
+    assert(outputImage != NULL);
+    assert(kernel      != NULL);
+
+    const SIZE imageSize = source->imageSize;
+
+    SourceRowReader* reader = CreateSourceRowReader(source, GetTuningProfile()->convolutionBandHeight + kernel->ksize.cy);
+
+    memset(outputImage, 0, sizeof(value_t) * imageSize.cx * imageSize.cy);
+
+    ConvolveRegionRows([&](int iy) { return ReadSourceRow(reader, iy); }, outputImage, imageSize, kernel, { 0, 0, imageSize.cx, imageSize.cy });
+
+    ReleaseSourceRowReader(reader);
+
+    return outputImage;
+}
+
+// +-----------------------------------------< RECURSIVE GAUSSIAN >-----------------------------------------+
+
+// Young and van Vliet's third-order recursive approximation of a Gaussian: a causal pass followed by an
+// anticausal one, each output[n] = gain * input[n] + feedback[0] * output[n -+ 1] + feedback[1] * output[n -+ 2]
+// + feedback[2] * output[n -+ 3]. The cost per sample does not depend on sigma, which must be at least 0.5.
+struct RecursiveGaussian
+{
+    double sigma;
+    float  gain;
+    float  feedback[3];
+};
+
+RecursiveGaussian CreateRecursiveGaussian(const double sigma);
+float*            FilterRecursiveGaussianRow(const RecursiveGaussian* filter, float* values, const int length);
+float*            FilterRecursiveGaussianColumns(const RecursiveGaussian* filter, float* image, SIZE imageSize);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
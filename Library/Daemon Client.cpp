@@ -0,0 +1,151 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Daemon Client.h"
+
+#if defined(__linux__)
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cassert>
+#include <cstring>
+
+// +-----------------------------------------------< DAEMON >-----------------------------------------------+
+
+static bool SendHello(int socketDescriptor, int memoryFile, uint32_t queueDepth)
+{
+    DaemonHello hello = { DAEMON_MAGIC, DAEMON_VERSION, queueDepth, 0 };
+    char        control[CMSG_SPACE(sizeof(int))];
+    iovec       vector = { &hello, sizeof(hello) };
+    msghdr      message;
+
+    memset(&message, 0, sizeof(message));
+    memset(control, 0, sizeof(control));
+
+    message.msg_iov        = &vector;
+    message.msg_iovlen     = 1;
+    message.msg_control    = control;
+    message.msg_controllen = sizeof(control);
+
+    cmsghdr* header = CMSG_FIRSTHDR(&message);
+
+    header->cmsg_level = SOL_SOCKET;
+    header->cmsg_type  = SCM_RIGHTS;
+    header->cmsg_len   = CMSG_LEN(sizeof(int));
+    memcpy(CMSG_DATA(header), &memoryFile, sizeof(int));
+
+    return sendmsg(socketDescriptor, &message, 0) == static_cast<ssize_t>(sizeof(hello));
+}
+
+// Creates the shared memory sealed against shrinking, hands it to the daemon and returns NULL if the daemon is
+// unreachable or refuses the connection. The granted queue depth may be lower than the requested one.
+DaemonClient* ConnectDaemon(const char* socketPath, size_t slotSize, uint32_t slotCount, uint32_t queueDepth)
+{
+    assert(socketPath != NULL);
+    assert(slotSize > 0 && slotCount > 0);
+
+    DaemonClient* client = new DaemonClient;
+
+    client->socket     = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    client->memoryFile = memfd_create("feature-extraction", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    client->memory     = static_cast<byte_t*>(MAP_FAILED);
+    client->slotSize   = slotSize;
+    client->slotCount  = slotCount;
+    client->nextSlot   = 0;
+    client->queueDepth = 0;
+
+    sockaddr_un address;
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, socketPath, sizeof(address.sun_path) - 1);
+
+    DaemonHelloReply reply;
+
+    if (client->socket < 0 || client->memoryFile < 0 || ftruncate(client->memoryFile, slotSize * slotCount) != 0 ||
+        fcntl(client->memoryFile, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) != 0 ||
+        (client->memory = static_cast<byte_t*>(mmap(NULL, slotSize * slotCount, PROT_READ | PROT_WRITE, MAP_SHARED, client->memoryFile, 0))) == MAP_FAILED ||
+        connect(client->socket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        !SendHello(client->socket, client->memoryFile, queueDepth) ||
+        recv(client->socket, &reply, sizeof(reply), 0) != static_cast<ssize_t>(sizeof(reply)) || reply.status != 0)
+    {
+        DisconnectDaemon(client);
+
+        return NULL;
+    }
+
+    client->queueDepth = reply.queueDepth;
+
+    return client;
+}
+
+void DisconnectDaemon(DaemonClient* client)
+{
+    assert(client != NULL);
+
+    if (client->memory != MAP_FAILED)
+        munmap(client->memory, client->slotSize * client->slotCount);
+    if (client->memoryFile >= 0)
+        close(client->memoryFile);
+    if (client->socket >= 0)
+        close(client->socket);
+
+    delete client;
+}
+
+byte_t* AcquireDaemonSlot(DaemonClient* client, uint64_t* offset)
+{
+    assert(client != NULL);
+    assert(offset != NULL);
+
+    *offset = static_cast<uint64_t>(client->nextSlot) * client->slotSize;
+
+    client->nextSlot = (client->nextSlot + 1) % client->slotCount;
+
+    return client->memory + *offset;
+}
+
+bool SubmitDaemonBatch(DaemonClient* client, const DaemonRequest* requests, uint32_t count)
+{
+    assert(client   != NULL);
+    assert(requests != NULL);
+    assert(count > 0 && count <= DAEMON_MAX_BATCH_SIZE);
+
+    DaemonBatchHeader header = { count, 0 };
+    iovec             vector[2];
+    msghdr            message;
+
+    vector[0].iov_base = &header;
+    vector[0].iov_len  = sizeof(header);
+    vector[1].iov_base = const_cast<DaemonRequest*>(requests);
+    vector[1].iov_len  = sizeof(DaemonRequest) * count;
+
+    memset(&message, 0, sizeof(message));
+    message.msg_iov    = vector;
+    message.msg_iovlen = 2;
+
+    return sendmsg(client->socket, &message, 0) == static_cast<ssize_t>(sizeof(header) + sizeof(DaemonRequest) * count);
+}
+
+// Blocks until the next batch completes and returns its response count, or -1 once the daemon has gone away.
+// Batches complete in any order; the tags identify the requests.
+int ReceiveDaemonBatch(DaemonClient* client, DaemonResponse* responses, uint32_t maxCount)
+{
+    assert(client    != NULL);
+    assert(responses != NULL);
+    assert(maxCount >= DAEMON_MAX_BATCH_SIZE);
+
+    ssize_t length = recv(client->socket, responses, sizeof(DaemonResponse) * maxCount, 0);
+
+    if (length <= 0 || length % sizeof(DaemonResponse) != 0)
+        return -1;
+
+    return static_cast<int>(length / sizeof(DaemonResponse));
+}
+
+#endif
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
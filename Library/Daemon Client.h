@@ -0,0 +1,31 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Daemon Protocol.h"
+
+// +-----------------------------------------------< DAEMON >-----------------------------------------------+
+
+// The shared memory is split into slotCount equal slots used as a ring; a slot must not be reused before the
+// response of the request that reads or writes it has been received, which holds as long as no more than
+// slotCount requests are outstanding.
+struct DaemonClient
+{
+    int      socket;
+    int      memoryFile;
+    byte_t*  memory;
+    size_t   slotSize;
+    uint32_t slotCount;
+    uint32_t nextSlot;
+    uint32_t queueDepth;
+};
+
+DaemonClient* ConnectDaemon(const char* socketPath, size_t slotSize, uint32_t slotCount, uint32_t queueDepth = DAEMON_DEFAULT_QUEUE_DEPTH);
+void          DisconnectDaemon(DaemonClient* client);
+byte_t*       AcquireDaemonSlot(DaemonClient* client, uint64_t* offset);
+bool          SubmitDaemonBatch(DaemonClient* client, const DaemonRequest* requests, uint32_t count);
+int           ReceiveDaemonBatch(DaemonClient* client, DaemonResponse* responses, uint32_t maxCount);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
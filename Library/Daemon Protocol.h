@@ -0,0 +1,89 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +-----------------------------------------------< DAEMON >-----------------------------------------------+
+
+// Wire format between Feature Extraction Daemon and its clients over a SOCK_SEQPACKET Unix domain socket.
+// A client first sends a DaemonHello carrying a memfd in SCM_RIGHTS; every later packet is one batch, a
+// DaemonBatchHeader followed by count DaemonRequests. The daemon answers each batch with one packet of count
+// DaemonResponses once every request of the batch has finished. Offsets address the client's shared memory,
+// so frames and results never travel through the socket.
+
+static const char* const DAEMON_SOCKET_PATH         = "/tmp/feature-extraction.sock";
+static const uint32_t    DAEMON_MAGIC               = 0x44584546;
+static const uint32_t    DAEMON_VERSION             = 1;
+static const uint32_t    DAEMON_MAX_BATCH_SIZE      = 64;
+static const uint32_t    DAEMON_MAX_QUEUE_DEPTH     = 256;
+static const uint32_t    DAEMON_DEFAULT_QUEUE_DEPTH = 16;
+
+enum DaemonOperation
+{
+    DAEMON_SOBEL_EDGE            = 0,
+    DAEMON_HARRIS_CORNER         = 1,
+    DAEMON_DILATION_EDGE         = 2,
+    DAEMON_EROSION_EDGE          = 3,
+    DAEMON_UNBIAS_EDGE           = 4,
+    DAEMON_UNBIAS_THRESHOLD_EDGE = 5,
+    DAEMON_ENTROPY_SKETCH_EDGE   = 6,
+    DAEMON_DP_EDGE               = 7,
+    DAEMON_DIP_EDGE              = 8,
+    DAEMON_OPERATION_COUNT       = 9
+};
+
+// Statuses below DAEMON_STATUS_QUEUE_FULL are the FEStatus values of Feature Extraction.h.
+enum DaemonStatus
+{
+    DAEMON_STATUS_QUEUE_FULL  = 100,
+    DAEMON_STATUS_BAD_REQUEST = 101
+};
+
+struct DaemonHello
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t queueDepth;
+    uint32_t reserved;
+};
+
+struct DaemonHelloReply
+{
+    int32_t  status;
+    uint32_t queueDepth;
+};
+
+struct DaemonBatchHeader
+{
+    uint32_t count;
+    uint32_t reserved;
+};
+
+// parameter is lamda for DAEMON_HARRIS_CORNER and the edge ratio of the threshold applied to the result for
+// the other operators, where 0 returns the unthresholded edge image. The input must stay unchanged until the
+// response for the request has arrived.
+struct DaemonRequest
+{
+    uint64_t tag;
+    uint32_t operation;
+    int32_t  width;
+    int32_t  height;
+    int32_t  wsize;
+    double   parameter;
+    uint64_t inputOffset;
+    uint64_t outputOffset;
+};
+
+struct DaemonResponse
+{
+    uint64_t tag;
+    int32_t  status;
+    uint32_t elapsedMicroseconds;
+};
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,218 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Density Index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+// +----------------------------------------------< DENSITY >-----------------------------------------------+
+
+DensityIndex* CreateDensityIndex(SIZE imageSize, const int tileSize)
+{
+    assert(imageSize.cx > 0 && imageSize.cy > 0);
+    assert(tileSize > 0);
+
+    DensityIndex* index = new DensityIndex;
+
+    index->imageSize = imageSize;
+    index->tileSize  = tileSize;
+    index->tileCount = { (imageSize.cx + tileSize - 1) / tileSize, (imageSize.cy + tileSize - 1) / tileSize };
+    index->counts    = new uint32_t[index->tileCount.cx * index->tileCount.cy];
+    index->integral  = new uint32_t[(index->tileCount.cx + 1) * (index->tileCount.cy + 1)];
+
+    memset(index->counts, 0, sizeof(uint32_t) * index->tileCount.cx * index->tileCount.cy);
+    memset(index->integral, 0, sizeof(uint32_t) * (index->tileCount.cx + 1) * (index->tileCount.cy + 1));
+
+    return index;
+}
+
+void ReleaseDensityIndex(DensityIndex* index)
+{
+    if (index == NULL)
+        return;
+
+    delete[] index->counts;
+    delete[] index->integral;
+
+    delete index;
+}
+
+// Clears the counts before a producer fills them; the index must have been created for imageSize.
+void ResetDensityIndex(DensityIndex* index, SIZE imageSize)
+{
+    assert(index != NULL);
+    assert(index->imageSize.cx == imageSize.cx);
+    assert(index->imageSize.cy == imageSize.cy);
+
+    memset(index->counts, 0, sizeof(uint32_t) * index->tileCount.cx * index->tileCount.cy);
+}
+
+// Adds the pixels of output row iy equal to featureValue to their tiles. Producers call it right after writing
+// the row, while it is still in cache.
+void AccumulateDensityRow(DensityIndex* index, const byte_t* row, const int iy, const byte_t featureValue)
+{
+    assert(index != NULL);
+    assert(row   != NULL);
+    assert(iy >= 0 && iy < index->imageSize.cy);
+
+    const int width    = index->imageSize.cx;
+    const int tileSize = index->tileSize;
+
+    uint32_t* counts = index->counts + (iy / tileSize) * index->tileCount.cx;
+
+    for (int tx = 0; tx < index->tileCount.cx; ++tx)
+    {
+        const int right = std::min((tx + 1) * tileSize, width);
+
+        uint32_t count = 0;
+
+        for (int ix = tx * tileSize; ix < right; ++ix)
+            count += row[ix] == featureValue;
+
+        counts[tx] += count;
+    }
+}
+
+// Builds the summed-area table once every row has been accumulated.
+void FinishDensityIndex(DensityIndex* index)
+{
+    assert(index != NULL);
+
+    const int stride = index->tileCount.cx + 1;
+
+    for (int ty = 0; ty < index->tileCount.cy; ++ty)
+    {
+        uint32_t rowSum = 0;
+
+        for (int tx = 0; tx < index->tileCount.cx; ++tx)
+        {
+            rowSum += index->counts[ty * index->tileCount.cx + tx];
+
+            index->integral[(ty + 1) * stride + (tx + 1)] = index->integral[ty * stride + (tx + 1)] + rowSum;
+        }
+    }
+}
+
+// Feature count of the tiles tileRect.left <= tx < tileRect.right, tileRect.top <= ty < tileRect.bottom.
+uint32_t CountDensityTiles(const DensityIndex* index, RECT tileRect)
+{
+    assert(index != NULL);
+    assert(tileRect.left >= 0 && tileRect.left <= tileRect.right && tileRect.right <= index->tileCount.cx);
+    assert(tileRect.top >= 0 && tileRect.top <= tileRect.bottom && tileRect.bottom <= index->tileCount.cy);
+
+    const int stride = index->tileCount.cx + 1;
+
+    return index->integral[tileRect.bottom * stride + tileRect.right] - index->integral[tileRect.top * stride + tileRect.right] -
+           index->integral[tileRect.bottom * stride + tileRect.left] + index->integral[tileRect.top * stride + tileRect.left];
+}
+
+// The pixel rectangle is clipped to the image and rounded out to whole tiles, so the count is exact for tile
+// aligned rectangles and otherwise includes the features of the partially covered tiles.
+static RECT CalculateDensityTileRect(const DensityIndex* index, RECT rect)
+{
+    const int left   = std::max<int>(rect.left, 0);
+    const int top    = std::max<int>(rect.top, 0);
+    const int right  = std::min<int>(rect.right, index->imageSize.cx);
+    const int bottom = std::min<int>(rect.bottom, index->imageSize.cy);
+
+    if (left >= right || top >= bottom)
+        return { 0, 0, 0, 0 };
+
+    RECT tileRect = { left / index->tileSize, top / index->tileSize, (right + index->tileSize - 1) / index->tileSize, (bottom + index->tileSize - 1) / index->tileSize };
+
+    return tileRect;
+}
+
+uint32_t CountDensityRect(const DensityIndex* index, RECT rect)
+{
+    assert(index != NULL);
+
+    return CountDensityTiles(index, CalculateDensityTileRect(index, rect));
+}
+
+// Fraction of feature pixels over the tiles covering rect, as counted by CountDensityRect.
+double CalculateDensity(const DensityIndex* index, RECT rect)
+{
+    assert(index != NULL);
+
+    const RECT tileRect = CalculateDensityTileRect(index, rect);
+    const int  left     = tileRect.left * index->tileSize;
+    const int  top      = tileRect.top * index->tileSize;
+    const int  right    = std::min<int>(tileRect.right * index->tileSize, index->imageSize.cx);
+    const int  bottom   = std::min<int>(tileRect.bottom * index->tileSize, index->imageSize.cy);
+
+    if (left >= right || top >= bottom)
+        return 0.0;
+
+    return CountDensityTiles(index, tileRect) / (static_cast<double>(right - left) * (bottom - top));
+}
+
+bool SaveDensityIndex(const DensityIndex* index, const char* fileName)
+{
+    assert(index    != NULL);
+    assert(fileName != NULL);
+
+    const size_t tileCount = static_cast<size_t>(index->tileCount.cx) * index->tileCount.cy;
+
+    DensityIndexHeader header;
+
+    memset(&header, 0, sizeof(header));
+
+    header.magic      = DENSITY_INDEX_MAGIC;
+    header.version    = DENSITY_INDEX_VERSION;
+    header.width      = index->imageSize.cx;
+    header.height     = index->imageSize.cy;
+    header.tileSize   = index->tileSize;
+    header.tileCountX = index->tileCount.cx;
+    header.tileCountY = index->tileCount.cy;
+
+    FILE* fileStream = fopen(fileName, "wb");
+
+    if (fileStream == NULL)
+        return false;
+
+    bool succeeded = fwrite(&header, sizeof(header), 1, fileStream) == 1 &&
+                     fwrite(index->counts, sizeof(uint32_t), tileCount, fileStream) == tileCount;
+
+    return (fclose(fileStream) == 0) && succeeded;
+}
+
+// Returns NULL if the file cannot be read or is not a density index.
+DensityIndex* LoadDensityIndex(const char* fileName)
+{
+    assert(fileName != NULL);
+
+    FILE* fileStream = fopen(fileName, "rb");
+
+    if (fileStream == NULL)
+        return NULL;
+
+    DensityIndexHeader header;
+    DensityIndex*      index = NULL;
+
+    if (fread(&header, sizeof(header), 1, fileStream) == 1 && header.magic == DENSITY_INDEX_MAGIC && header.version == DENSITY_INDEX_VERSION &&
+        header.width > 0 && header.height > 0 && header.tileSize > 0 &&
+        header.tileCountX == (header.width + header.tileSize - 1) / header.tileSize &&
+        header.tileCountY == (header.height + header.tileSize - 1) / header.tileSize)
+    {
+        const size_t tileCount = static_cast<size_t>(header.tileCountX) * header.tileCountY;
+
+        index = CreateDensityIndex({ header.width, header.height }, header.tileSize);
+
+        if (fread(index->counts, sizeof(uint32_t), tileCount, fileStream) == tileCount)
+            FinishDensityIndex(index);
+        else
+        {
+            ReleaseDensityIndex(index);
+            index = NULL;
+        }
+    }
+
+    fclose(fileStream);
+
+    return index;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
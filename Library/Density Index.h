@@ -0,0 +1,59 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +----------------------------------------------< DENSITY >-----------------------------------------------+
+
+static const int      DENSITY_INDEX_TILE_SIZE = 32;
+static const uint32_t DENSITY_INDEX_MAGIC     = 0x58444946;
+static const uint32_t DENSITY_INDEX_VERSION   = 1;
+
+// Feature pixel counts of tileSize x tileSize tiles of a binary output, filled in by the producers as they write
+// it, with the summed-area table of the counts: integral has (tileCount.cx + 1) * (tileCount.cy + 1) entries,
+// the first row and column being zero, so the count of any range of tiles is four reads.
+//
+// Producers taking a DensityIndex* (the edge ratio thresholds, FindZeroCrossing, HarrisCorner) reset it to
+// their image size, accumulate each row as it is written, skipping border rows that hold no features, and
+// finish it before returning; edges count the value 0 and corners the value 255. A NULL index builds nothing.
+struct DensityIndex
+{
+    SIZE      imageSize;
+    int       tileSize;
+    SIZE      tileCount;
+    uint32_t* counts;
+    uint32_t* integral;
+};
+
+// A saved index is this header followed by the tile counts; the summed-area table is rebuilt on loading.
+struct DensityIndexHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    int32_t  width;
+    int32_t  height;
+    int32_t  tileSize;
+    int32_t  tileCountX;
+    int32_t  tileCountY;
+    uint32_t reserved;
+};
+
+DensityIndex* CreateDensityIndex(SIZE imageSize, const int tileSize = DENSITY_INDEX_TILE_SIZE);
+void          ReleaseDensityIndex(DensityIndex* index);
+void          ResetDensityIndex(DensityIndex* index, SIZE imageSize);
+void          AccumulateDensityRow(DensityIndex* index, const byte_t* row, const int iy, const byte_t featureValue);
+void          FinishDensityIndex(DensityIndex* index);
+
+uint32_t      CountDensityTiles(const DensityIndex* index, RECT tileRect);
+uint32_t      CountDensityRect(const DensityIndex* index, RECT rect);
+double        CalculateDensity(const DensityIndex* index, RECT rect);
+
+bool          SaveDensityIndex(const DensityIndex* index, const char* fileName);
+DensityIndex* LoadDensityIndex(const char* fileName);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
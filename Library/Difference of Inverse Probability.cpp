@@ -0,0 +1,45 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Difference of Inverse Probability.h"
+#include "Utility.h"
+
+#include <cassert>
+#include <cstring>
+
+// +------------------------------------------------< DIP >-------------------------------------------------+
+
+byte_t* DIPEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage   != NULL);
+    assert(outputImage  != NULL);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    lbyte_t* integralImage = new lbyte_t[width * height];
+    double*  DIPImage      = new double[width * height];
+
+    memset(outputImage, 255, sizeof(byte_t) * width * height);
+    memset(DIPImage, 0, sizeof(double) * width * height);
+
+    CreateIntegralImage(inputImage, integralImage, imageSize);
+
+    for (int iy = wsize.cy / 2; iy < height - wsize.cy / 2; ++iy)
+        for (int ix = wsize.cx / 2; ix < width - wsize.cx / 2; ++ix)
+        {
+            double mean = CalculateIntegralWindowAverage(integralImage, imageSize, { ix, iy }, wsize);
+
+            DIPImage[iy * width + ix] = mean / inputImage[iy * width + ix] - mean / CalculateWindowMax(inputImage, imageSize, { ix, iy }, wsize);
+        }
+
+    Normalization(DIPImage, outputImage, imageSize);
+
+    delete[] integralImage;
+    delete[] DIPImage;
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
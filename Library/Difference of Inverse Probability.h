@@ -0,0 +1,13 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+// +------------------------------------------------< DIP >-------------------------------------------------+
+
+byte_t* DIPEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,13 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+// +-------------------------------------------------< DP >-------------------------------------------------+
+
+byte_t* DPEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,191 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Distance Transform.h"
+#include "Connected Component.h"
+#include "Reduction.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <thread>
+
+// +----------------------------------------------< DISTANCE >----------------------------------------------+
+
+static int ResolveThreadCount(const int threadCount, const size_t workCount)
+{
+    const int hardwareThreadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+    return static_cast<int>(std::min<size_t>(std::max<size_t>(workCount, 1), (threadCount > 0) ? (threadCount) : (hardwareThreadCount)));
+}
+
+// Felzenszwalb and Huttenlocher's 1D squared distance transform, distances[q] = min over p of (q - p)^2 +
+// values[p], as the lower envelope of the parabolas rooted at every p. vertices and bounds hold the envelope and
+// need length and length + 1 entries.
+static void TransformSquaredDistanceRow(const double* values, double* distances, const int length, int* vertices, double* bounds)
+{
+    int vertexCount = 0;
+
+    vertices[0] = 0;
+    bounds[0]   = -HUGE_VAL;
+    bounds[1]   = HUGE_VAL;
+
+    for (int q = 1; q < length; ++q)
+    {
+        double intersection = 0.0;
+
+        // Parabolas hidden by the new one are dropped; bounds[0] is -infinity, so the first one never is.
+        while (true)
+        {
+            const int p = vertices[vertexCount];
+
+            intersection = ((values[q] + static_cast<double>(q) * q) - (values[p] + static_cast<double>(p) * p)) / (2.0 * (q - p));
+
+            if (intersection > bounds[vertexCount])
+                break;
+
+            vertexCount--;
+        }
+
+        vertexCount++;
+        vertices[vertexCount]   = q;
+        bounds[vertexCount]     = intersection;
+        bounds[vertexCount + 1] = HUGE_VAL;
+    }
+
+    for (int q = 0, vertex = 0; q < length; ++q)
+    {
+        while (bounds[vertex + 1] < q)
+            vertex++;
+
+        const int p = vertices[vertex];
+
+        distances[q] = static_cast<double>(q - p) * (q - p) + values[p];
+    }
+}
+
+// Exact Euclidean distance of every pixel to the nearest edge pixel (EDGE_PIXEL_VALUE), as the binary outputs of
+// the edge ratio thresholds and UnbiasEdge mark them. The column pass reduces to the distance to the nearest
+// edge of the column, found by a downward and an upward sweep over whole rows, with the columns split among the
+// threads; the row pass is the Felzenszwalb-Huttenlocher transform of the squared column distances, with the
+// rows split among the threads. Both are linear in the pixel count.
+float* EdgeDistanceTransform(const byte_t* edgeImage, float* distanceImage, SIZE imageSize, int threadCount)
+{
+    assert(edgeImage     != NULL);
+    assert(distanceImage != NULL);
+
+    const int     width            = imageSize.cx;
+    const int     height           = imageSize.cy;
+    const int32_t noEdge           = width + height;
+    const double  infiniteDistance = static_cast<double>(DISTANCE_TRANSFORM_INFINITY) * DISTANCE_TRANSFORM_INFINITY;
+
+    int32_t* columnDistances = new int32_t[width * height];
+
+    threadCount = ResolveThreadCount(threadCount, width);
+
+    RunReductionThreads(threadCount, [&](int thread) {
+        const int left  = width * thread / threadCount;
+        const int right = width * (thread + 1) / threadCount;
+
+        for (int ix = left; ix < right; ++ix)
+            columnDistances[ix] = (edgeImage[ix] == EDGE_PIXEL_VALUE) ? (0) : (noEdge);
+
+        for (int iy = 1; iy < height; ++iy)
+            for (int ix = left; ix < right; ++ix)
+                columnDistances[iy * width + ix] = (edgeImage[iy * width + ix] == EDGE_PIXEL_VALUE) ? (0) : (std::min(columnDistances[(iy - 1) * width + ix] + 1, noEdge));
+
+        for (int iy = height - 2; iy >= 0; --iy)
+            for (int ix = left; ix < right; ++ix)
+                columnDistances[iy * width + ix] = std::min(columnDistances[iy * width + ix], columnDistances[(iy + 1) * width + ix] + 1);
+    });
+
+    threadCount = ResolveThreadCount(threadCount, height);
+
+    RunReductionThreads(threadCount, [&](int thread) {
+        double* values    = new double[width];
+        double* distances = new double[width];
+        int*    vertices  = new int[width];
+        double* bounds    = new double[width + 1];
+
+        for (int iy = height * thread / threadCount; iy < height * (thread + 1) / threadCount; ++iy)
+        {
+            for (int ix = 0; ix < width; ++ix)
+            {
+                const int32_t columnDistance = columnDistances[iy * width + ix];
+
+                values[ix] = (columnDistance >= noEdge) ? (infiniteDistance) : (static_cast<double>(columnDistance) * columnDistance);
+            }
+
+            TransformSquaredDistanceRow(values, distances, width, vertices, bounds);
+
+            for (int ix = 0; ix < width; ++ix)
+                distanceImage[iy * width + ix] = static_cast<float>(std::min(sqrt(distances[ix]), static_cast<double>(DISTANCE_TRANSFORM_INFINITY)));
+        }
+
+        delete[] values;
+        delete[] distances;
+        delete[] vertices;
+        delete[] bounds;
+    });
+
+    delete[] columnDistances;
+
+    return distanceImage;
+}
+
+// +----------------------------------------------< CHAMFER >-----------------------------------------------+
+
+// The edge pixels of a template edge image in raster order, as offsets from its top-left corner; returns how
+// many were stored.
+size_t ExtractEdgePoints(const byte_t* edgeImage, SIZE imageSize, POINT* points, const size_t maxPointCount)
+{
+    assert(edgeImage != NULL);
+    assert(points    != NULL);
+
+    size_t pointCount = 0;
+
+    for (int iy = 0; iy < imageSize.cy; ++iy)
+        for (int ix = 0; ix < imageSize.cx && pointCount < maxPointCount; ++ix)
+            if (edgeImage[iy * imageSize.cx + ix] == EDGE_PIXEL_VALUE)
+                points[pointCount++] = { ix, iy };
+
+    return pointCount;
+}
+
+// The truncated chamfer distance of the template at every placement: the mean over the template points of the
+// distance map at placement + point, each capped at truncation, which a point outside the image also counts
+// as. Lower is better. The placements are split among the threads.
+float* ScoreChamferPlacements(const float* distanceImage, SIZE imageSize, const POINT* templatePoints, const size_t templatePointCount, const POINT* placements, const size_t placementCount, float* scores, const float truncation, int threadCount)
+{
+    assert(distanceImage  != NULL);
+    assert(templatePoints != NULL);
+    assert(placements     != NULL);
+    assert(scores         != NULL);
+    assert(templatePointCount > 0);
+    assert(truncation > 0.0f);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    threadCount = ResolveThreadCount(threadCount, placementCount);
+
+    RunReductionThreads(threadCount, [&](int thread) {
+        for (size_t placement = placementCount * thread / threadCount; placement < placementCount * (thread + 1) / threadCount; ++placement)
+        {
+            double distanceSum = 0.0;
+
+            for (size_t point = 0; point < templatePointCount; ++point)
+            {
+                const int x = placements[placement].x + templatePoints[point].x;
+                const int y = placements[placement].y + templatePoints[point].y;
+
+                distanceSum += (x >= 0 && x < width && y >= 0 && y < height) ? (std::min(distanceImage[y * width + x], truncation)) : (truncation);
+            }
+
+            scores[placement] = static_cast<float>(distanceSum / templatePointCount);
+        }
+    });
+
+    return scores;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
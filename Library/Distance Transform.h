@@ -0,0 +1,23 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +----------------------------------------------< DISTANCE >----------------------------------------------+
+
+// The distance given to every pixel of an image without edge pixels.
+static const float DISTANCE_TRANSFORM_INFINITY = 1e10f;
+
+float* EdgeDistanceTransform(const byte_t* edgeImage, float* distanceImage, SIZE imageSize, int threadCount = 0);
+
+// +----------------------------------------------< CHAMFER >-----------------------------------------------+
+
+size_t ExtractEdgePoints(const byte_t* edgeImage, SIZE imageSize, POINT* points, const size_t maxPointCount);
+float* ScoreChamferPlacements(const float* distanceImage, SIZE imageSize, const POINT* templatePoints, const size_t templatePointCount, const POINT* placements, const size_t placementCount, float* scores, const float truncation, int threadCount = 0);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,132 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Entropy Sketch.h"
+#include "Utility.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstring>
+
+// +-------------------------------------------< ENTROPY SKETCH >-------------------------------------------+
+
+byte_t* EntropySketchEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    lbyte_t* integralImage = new lbyte_t[imageSize.cx * imageSize.cy];
+
+    CreateIntegralImage(inputImage, integralImage, imageSize);
+    EntropySketchEdge(inputImage, outputImage, imageSize, wsize, integralImage, NULL);
+
+    delete[] integralImage;
+
+    return outputImage;
+}
+
+// With a tileMask (TILE_SIZE tiles, as laid out by CalculateTileCount) only the selected tiles are evaluated
+// and the others are given the entropy of a flat window, so they show no edges.
+byte_t* EntropySketchEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const lbyte_t* integralImage, const bool* tileMask)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    double* entropyImage = new double[imageSize.cx * imageSize.cy];
+
+    memset(outputImage, 255, sizeof(byte_t) * imageSize.cx * imageSize.cy);
+
+    CalculateEntropySketch(inputImage, entropyImage, imageSize, wsize, integralImage, tileMask);
+    Normalization(entropyImage, outputImage, imageSize);
+
+    delete[] entropyImage;
+
+    return outputImage;
+}
+
+// The unnormalized window entropies, zero on the border. The window sums come from integralImage, the integral
+// image of inputImage; being integers they equal the directly summed ones exactly.
+double* CalculateEntropySketch(const byte_t* inputImage, double* entropyImage, SIZE imageSize, SIZE wsize, const lbyte_t* integralImage, const bool* tileMask)
+{
+    assert(inputImage    != NULL);
+    assert(entropyImage  != NULL);
+    assert(integralImage != NULL);
+    assert(wsize.cx % 2  == 1);
+    assert(wsize.cy % 2  == 1);
+
+    const int    width       = imageSize.cx;
+    const int    height      = imageSize.cy;
+    const SIZE   tileCount   = CalculateTileCount(imageSize);
+    const double flatEntropy = log2(static_cast<double>(wsize.cx * wsize.cy));
+
+    memset(entropyImage, 0, sizeof(double) * width * height);
+
+    for (int iy = wsize.cy / 2; iy < height - wsize.cy / 2; ++iy)
+        for (int ix = wsize.cx / 2; ix < width - wsize.cx / 2; ++ix)
+        {
+            if (tileMask != NULL && !tileMask[(iy / TILE_SIZE) * tileCount.cx + ix / TILE_SIZE])
+            {
+                entropyImage[iy * width + ix] = flatEntropy;
+                continue;
+            }
+
+            double pixelSum = CalculateIntegralWindowSum(integralImage, imageSize, { ix, iy }, wsize);
+
+            for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+                for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+                    entropyImage[iy * width + ix] += log2(inputImage[(iy + wy) * width + (ix + wx)] / pixelSum) * inputImage[(iy + wy) * width + (ix + wx)] / pixelSum;
+            entropyImage[iy * width + ix] = -entropyImage[iy * width + ix];
+        }
+
+    return entropyImage;
+}
+
+// Tile-major evaluation for blocked images. The window sums are taken directly from the window gathered around
+// each block; being integers they equal the integral image ones, so the result equals the row-major one.
+BlockedImage* EntropySketchEdge(const BlockedImage* inputImage, BlockedImage* outputImage, SIZE wsize)
+{
+    assert(inputImage   != NULL);
+    assert(outputImage  != NULL);
+    assert(inputImage->imageSize.cx == outputImage->imageSize.cx);
+    assert(inputImage->imageSize.cy == outputImage->imageSize.cy);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int width  = inputImage->imageSize.cx;
+    const int height = inputImage->imageSize.cy;
+
+    double* entropyBlocks = new double[static_cast<size_t>(inputImage->blockCount.cx) * inputImage->blockCount.cy * IMAGE_BLOCK_PIXEL_COUNT];
+
+    ForEachImageBlock(inputImage, { wsize.cx / 2, wsize.cy / 2 }, [&](int bx, int by, RECT blockRect, const byte_t* window, RECT windowRect) {
+        const int windowWidth  = windowRect.right - windowRect.left;
+        double*   entropyBlock = entropyBlocks + CalculateBlockOffset(inputImage, bx, by);
+
+        memset(entropyBlock, 0, sizeof(double) * IMAGE_BLOCK_PIXEL_COUNT);
+
+        for (int iy = std::max<int>(blockRect.top, wsize.cy / 2); iy < std::min<int>(blockRect.bottom, height - wsize.cy / 2); ++iy)
+            for (int ix = std::max<int>(blockRect.left, wsize.cx / 2); ix < std::min<int>(blockRect.right, width - wsize.cx / 2); ++ix)
+            {
+                const byte_t* center    = window + (iy - windowRect.top) * windowWidth + (ix - windowRect.left);
+                double*       entropy   = entropyBlock + (iy - blockRect.top) * IMAGE_BLOCK_SIZE + (ix - blockRect.left);
+                lbyte_t       windowSum = 0;
+
+                for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+                    for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+                        windowSum += center[wy * windowWidth + wx];
+
+                const double pixelSum = windowSum;
+
+                for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+                    for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+                        *entropy += log2(center[wy * windowWidth + wx] / pixelSum) * center[wy * windowWidth + wx] / pixelSum;
+                *entropy = -*entropy;
+            }
+    });
+
+    NormalizeBlockedImage(entropyBlocks, outputImage);
+
+    delete[] entropyBlocks;
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
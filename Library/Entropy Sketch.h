@@ -0,0 +1,17 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Blocked Image.h"
+
+// +-------------------------------------------< ENTROPY SKETCH >-------------------------------------------+
+
+byte_t*       EntropySketchEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+byte_t*       EntropySketchEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const lbyte_t* integralImage, const bool* tileMask);
+BlockedImage* EntropySketchEdge(const BlockedImage* inputImage, BlockedImage* outputImage, SIZE wsize);
+double*       CalculateEntropySketch(const byte_t* inputImage, double* entropyImage, SIZE imageSize, SIZE wsize, const lbyte_t* integralImage, const bool* tileMask = NULL);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,166 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Feature Extraction.h"
+#include "Feature Extraction.hpp"
+
+#include <new>
+
+// +---------------------------------------------< VALIDATION >---------------------------------------------+
+
+static_assert(sizeof(byte_t) == sizeof(uint8_t), "byte_t must be a single byte");
+
+static SIZE ToSize(FESize size)
+{
+    SIZE result = { size.width, size.height };
+
+    return result;
+}
+
+static bool IsValidImage(const uint8_t* inputImage, const uint8_t* outputImage, FESize imageSize)
+{
+    if (inputImage == NULL || outputImage == NULL || imageSize.width <= 0 || imageSize.height <= 0)
+        return false;
+
+    const size_t pixelCount = static_cast<size_t>(imageSize.width) * imageSize.height;
+
+    // Offsets are computed in int, so larger images would overflow inside the operators.
+    if (pixelCount > static_cast<size_t>(INT32_MAX))
+        return false;
+
+    return true;
+}
+
+static bool IsDisjoint(const uint8_t* inputImage, const uint8_t* outputImage, FESize imageSize)
+{
+    const size_t pixelCount = static_cast<size_t>(imageSize.width) * imageSize.height;
+
+    return outputImage + pixelCount <= inputImage || inputImage + pixelCount <= outputImage;
+}
+
+static bool IsValidWindow(FESize wsize, FESize imageSize)
+{
+    return wsize.width > 0 && wsize.height > 0 && wsize.width % 2 == 1 && wsize.height % 2 == 1 &&
+           wsize.width <= imageSize.width && wsize.height <= imageSize.height;
+}
+
+// Runs function without letting an exception cross the C boundary.
+template <typename function_t>
+static FEStatus RunGuarded(function_t function)
+{
+    try
+    {
+        return function();
+    }
+    catch (const std::bad_alloc&)
+    {
+        return FE_STATUS_OUT_OF_MEMORY;
+    }
+    catch (...)
+    {
+        return FE_STATUS_INTERNAL_ERROR;
+    }
+}
+
+// Runs a window operator after the checks the C++ entry points only assert.
+template <typename operator_t>
+static FEStatus RunWindowOperator(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize, operator_t function)
+{
+    if (!IsValidImage(inputImage, outputImage, imageSize) || !IsDisjoint(inputImage, outputImage, imageSize) || !IsValidWindow(wsize, imageSize))
+        return FE_STATUS_INVALID_ARGUMENT;
+
+    return RunGuarded([&]() -> FEStatus { function(inputImage, outputImage, ToSize(imageSize), ToSize(wsize)); return FE_STATUS_OK; });
+}
+
+// +------------------------------------------------< EDGE >------------------------------------------------+
+
+FEStatus FESobelEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize)
+{
+    const FESize wsize = { 3, 3 };
+
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [](const byte_t* input, byte_t* output, SIZE size, SIZE) { SobelEdge(input, output, size); });
+}
+
+FEStatus FEHarrisCorner(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, int32_t wsize, double lamda)
+{
+    const FESize window = { wsize, wsize };
+
+    return RunWindowOperator(inputImage, outputImage, imageSize, window, [lamda](const byte_t* input, byte_t* output, SIZE size, SIZE window) { HarrisCorner(input, output, size, window.cx, lamda); });
+}
+
+FEStatus FEDilationEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize)
+{
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [](const byte_t* input, byte_t* output, SIZE size, SIZE window) { DilationEdge(input, output, size, window); });
+}
+
+FEStatus FEErosionEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize)
+{
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [](const byte_t* input, byte_t* output, SIZE size, SIZE window) { ErosionEdge(input, output, size, window); });
+}
+
+FEStatus FEUnbiasEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize)
+{
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [](const byte_t* input, byte_t* output, SIZE size, SIZE window) { UnbiasEdge(input, output, size, window); });
+}
+
+FEStatus FELocalVarianceThreshold(const uint8_t* inputImage, const uint8_t* unbiasEdgeImage, uint8_t* outputImage, FESize imageSize, FESize wsize)
+{
+    if (unbiasEdgeImage == NULL || !IsDisjoint(unbiasEdgeImage, outputImage, imageSize))
+        return FE_STATUS_INVALID_ARGUMENT;
+
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [unbiasEdgeImage](const byte_t* input, byte_t* output, SIZE size, SIZE window) { LocalVarianceThreshold(input, unbiasEdgeImage, output, size, window); });
+}
+
+FEStatus FEEntropySketchEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize)
+{
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [](const byte_t* input, byte_t* output, SIZE size, SIZE window) { EntropySketchEdge(input, output, size, window); });
+}
+
+FEStatus FEDPEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize)
+{
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [](const byte_t* input, byte_t* output, SIZE size, SIZE window) { DPEdge(input, output, size, window); });
+}
+
+FEStatus FEDIPEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize)
+{
+    return RunWindowOperator(inputImage, outputImage, imageSize, wsize, [](const byte_t* input, byte_t* output, SIZE size, SIZE window) { DIPEdge(input, output, size, window); });
+}
+
+// +---------------------------------------------< THRESHOLD >----------------------------------------------+
+
+FEStatus FEMaxEdgeRatioThreshold(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, double edgeRatio)
+{
+    if (!IsValidImage(inputImage, outputImage, imageSize) || !(edgeRatio > 0.0 && edgeRatio <= 1.0))
+        return FE_STATUS_INVALID_ARGUMENT;
+
+    return RunGuarded([&]() -> FEStatus { MaxEdgeRatioThreshold(inputImage, outputImage, ToSize(imageSize), edgeRatio); return FE_STATUS_OK; });
+}
+
+FEStatus FEMinEdgeRatioThreshold(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, double edgeRatio)
+{
+    if (!IsValidImage(inputImage, outputImage, imageSize) || !(edgeRatio > 0.0 && edgeRatio <= 1.0))
+        return FE_STATUS_INVALID_ARGUMENT;
+
+    return RunGuarded([&]() -> FEStatus { MinEdgeRatioThreshold(inputImage, outputImage, ToSize(imageSize), edgeRatio); return FE_STATUS_OK; });
+}
+
+// +-----------------------------------------------< TUNING >-----------------------------------------------+
+
+FEStatus FELoadTuningProfile(const char* fileName)
+{
+    return RunGuarded([fileName]() -> FEStatus
+    {
+        TuningProfile profile;
+
+        if (fileName == NULL)
+            return LoadDefaultTuningProfile() ? FE_STATUS_OK : FE_STATUS_INVALID_ARGUMENT;
+
+        if (!LoadTuningProfile(fileName, &profile))
+            return FE_STATUS_INVALID_ARGUMENT;
+
+        SetTuningProfile(&profile);
+
+        return FE_STATUS_OK;
+    });
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,71 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// The sources are compiled into the caller; outside Windows the entry points keep default visibility so
+// that a build with -fvisibility=hidden still exports them.
+#if defined(_WIN32)
+    #define FE_API
+#else
+    #define FE_API __attribute__((visibility("default")))
+#endif
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__cplusplus)
+extern "C" {
+#endif
+
+// +------------------------------------------------< TYPE >------------------------------------------------+
+
+// Images are 8 bit grayscale, row-major and tightly packed (stride == width). Every buffer is owned by the
+// caller; the library never keeps a pointer past the call that received it.
+typedef enum FEStatus
+{
+    FE_STATUS_OK               = 0,
+    FE_STATUS_INVALID_ARGUMENT = 1,
+    FE_STATUS_OUT_OF_MEMORY    = 2,
+    FE_STATUS_INTERNAL_ERROR   = 3
+} FEStatus;
+
+typedef struct FESize
+{
+    int32_t width;
+    int32_t height;
+} FESize;
+
+// +------------------------------------------------< EDGE >------------------------------------------------+
+
+// inputImage and outputImage are imageSize.width * imageSize.height bytes and must not overlap. Window sizes
+// are odd and no larger than the image.
+FE_API FEStatus FESobelEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize);
+FE_API FEStatus FEHarrisCorner(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, int32_t wsize, double lamda);
+FE_API FEStatus FEDilationEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize);
+FE_API FEStatus FEErosionEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize);
+FE_API FEStatus FEUnbiasEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize);
+FE_API FEStatus FELocalVarianceThreshold(const uint8_t* inputImage, const uint8_t* unbiasEdgeImage, uint8_t* outputImage, FESize imageSize, FESize wsize);
+FE_API FEStatus FEEntropySketchEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize);
+FE_API FEStatus FEDPEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize);
+FE_API FEStatus FEDIPEdge(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, FESize wsize);
+
+// +---------------------------------------------< THRESHOLD >----------------------------------------------+
+
+// Binarize an edge magnitude image so that about edgeRatio of the pixels become edges (0). These may run in
+// place.
+FE_API FEStatus FEMaxEdgeRatioThreshold(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, double edgeRatio);
+FE_API FEStatus FEMinEdgeRatioThreshold(const uint8_t* inputImage, uint8_t* outputImage, FESize imageSize, double edgeRatio);
+
+// +-----------------------------------------------< TUNING >-----------------------------------------------+
+
+// Activates the tuning profile written by Feature Extraction Autotune; with a NULL fileName, the one named by
+// FE_TUNING_PROFILE or "Feature Extraction.profile" in the working directory. Call it before processing.
+FE_API FEStatus FELoadTuningProfile(const char* fileName);
+
+#if defined(__cplusplus)
+}
+#endif
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,37 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+// C++ interface: the operator headers themselves, taking caller-owned buffers and a runtime image size. C
+// callers and other languages use the status-returning functions of Feature Extraction.h instead.
+#include "Common.h"
+#include "Autotune.h"
+#include "Reduction.h"
+#include "Utility.h"
+#include "Blocked Image.h"
+#include "Convolution.h"
+#include "Structuring Element.h"
+#include "Sobel.h"
+#include "Harris Corner Detector.h"
+#include "Nonlinear Gradient.h"
+#include "Nonlinear Laplacian.h"
+#include "Entropy Sketch.h"
+#include "Difference of Probability.h"
+#include "Difference of Inverse Probability.h"
+#include "Pyramid.h"
+#include "Progressive.h"
+#include "Shard Coordinator.h"
+#include "Realtime Scheduler.h"
+#include "Result Cache.h"
+#include "Connected Component.h"
+#include "Sliding Histogram.h"
+#include "Pipeline.h"
+#include "Feature Tracker.h"
+#include "Density Index.h"
+#include "Image Source.h"
+#include "Morphology.h"
+#include "Distance Transform.h"
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
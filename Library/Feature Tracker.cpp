@@ -0,0 +1,393 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Feature Tracker.h"
+#include "Harris Corner Detector.h"
+#include "Reduction.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// +------------------------------------------< FEATURE TRACKER >-------------------------------------------+
+
+static const int   MAX_TRACKER_PATCH_RADIUS = 15;
+static const int   MAX_TRACKER_PATCH_SIZE   = (2 * MAX_TRACKER_PATCH_RADIUS + 1) * (2 * MAX_TRACKER_PATCH_RADIUS + 1);
+static const float SOBEL_GRADIENT_SCALE     = 1.0f / 8.0f;
+
+// Bilinear samples of a (2 * radius + 1)^2 patch centered at (x, y). The fractional weights are the same for
+// every pixel of the patch, so away from the border each sample is four multiplies on contiguous rows; near
+// the border the coordinates are clamped to the image.
+template <typename value_t>
+static void SamplePatch(const value_t* image, SIZE imageSize, const float x, const float y, const int radius, const float scale, float* patch)
+{
+    const int   width  = imageSize.cx;
+    const int   height = imageSize.cy;
+    const int   size   = 2 * radius + 1;
+    const float fx     = floorf(x);
+    const float fy     = floorf(y);
+    const int   left   = static_cast<int>(fx) - radius;
+    const int   top    = static_cast<int>(fy) - radius;
+    const float ax     = x - fx;
+    const float ay     = y - fy;
+    const float w00    = (1.0f - ax) * (1.0f - ay) * scale;
+    const float w01    = ax * (1.0f - ay) * scale;
+    const float w10    = (1.0f - ax) * ay * scale;
+    const float w11    = ax * ay * scale;
+
+    if (left >= 0 && top >= 0 && left + size < width && top + size < height)
+    {
+        for (int py = 0; py < size; ++py)
+        {
+            const value_t* upper = image + (top + py) * width + left;
+            const value_t* lower = upper + width;
+            float*         row   = patch + py * size;
+
+            for (int px = 0; px < size; ++px)
+                row[px] = w00 * upper[px] + w01 * upper[px + 1] + w10 * lower[px] + w11 * lower[px + 1];
+        }
+
+        return;
+    }
+
+    for (int py = 0; py < size; ++py)
+        for (int px = 0; px < size; ++px)
+        {
+            const int x0 = std::min(std::max(left + px, 0), width - 1);
+            const int x1 = std::min(std::max(left + px + 1, 0), width - 1);
+            const int y0 = std::min(std::max(top + py, 0), height - 1);
+            const int y1 = std::min(std::max(top + py + 1, 0), height - 1);
+
+            patch[py * size + px] = w00 * image[y0 * width + x0] + w01 * image[y0 * width + x1] + w10 * image[y1 * width + x0] + w11 * image[y1 * width + x1];
+        }
+}
+
+// Bouguet's pyramidal Lucas-Kanade for one point: the displacement found at each level, doubled, is the
+// initial guess of the level below. The template patch and its gradients come from the previous frame and
+// are sampled once per level; only the moving patch is sampled per iteration.
+static bool TrackPyramidPoint(ImagePyramid* previousPyramid, ImagePyramid* nextPyramid, const TrackedPoint* previousPoint, TrackedPoint* nextPoint, const FeatureTrackerOptions* options)
+{
+    const int radius     = options->patchRadius;
+    const int size       = 2 * radius + 1;
+    const int patchCount = size * size;
+
+    float templatePatch[MAX_TRACKER_PATCH_SIZE];
+    float gradientX[MAX_TRACKER_PATCH_SIZE];
+    float gradientY[MAX_TRACKER_PATCH_SIZE];
+    float movingPatch[MAX_TRACKER_PATCH_SIZE];
+
+    float guessX    = 0.0f;
+    float guessY    = 0.0f;
+    float residual  = 0.0f;
+
+    for (int level = options->levelCount - 1; level >= 0; --level)
+    {
+        const PyramidLevel* previous = &previousPyramid->levels[level];
+        const PyramidLevel* next     = &nextPyramid->levels[level];
+        const float         scale    = 1.0f / static_cast<float>(1 << level);
+        const float         x        = previousPoint->x * scale;
+        const float         y        = previousPoint->y * scale;
+
+        SamplePatch(previous->image, previous->imageSize, x, y, radius, 1.0f, templatePatch);
+        SamplePatch(previous->magnitudeX, previous->imageSize, x, y, radius, SOBEL_GRADIENT_SCALE, gradientX);
+        SamplePatch(previous->magnitudeY, previous->imageSize, x, y, radius, SOBEL_GRADIENT_SCALE, gradientY);
+
+        float gxx = 0.0f;
+        float gyy = 0.0f;
+        float gxy = 0.0f;
+
+        for (int index = 0; index < patchCount; ++index)
+        {
+            gxx += gradientX[index] * gradientX[index];
+            gyy += gradientY[index] * gradientY[index];
+            gxy += gradientX[index] * gradientY[index];
+        }
+
+        const float determinant   = gxx * gyy - gxy * gxy;
+        const float minEigenvalue = (gxx + gyy - sqrtf((gxx - gyy) * (gxx - gyy) + 4.0f * gxy * gxy)) / (2.0f * patchCount);
+
+        // A coarse level too flat to solve passes its guess on unchanged; only the finest level decides.
+        const bool solvable = minEigenvalue >= options->minEigenvalue && determinant > 0.0f;
+
+        if (!solvable && level == 0)
+            return false;
+
+        float flowX = 0.0f;
+        float flowY = 0.0f;
+
+        for (int iteration = 0; iteration < options->maxIterationCount && solvable; ++iteration)
+        {
+            SamplePatch(next->image, next->imageSize, x + guessX + flowX, y + guessY + flowY, radius, 1.0f, movingPatch);
+
+            float bx = 0.0f;
+            float by = 0.0f;
+
+            for (int index = 0; index < patchCount; ++index)
+            {
+                const float difference = templatePatch[index] - movingPatch[index];
+
+                bx += difference * gradientX[index];
+                by += difference * gradientY[index];
+            }
+
+            const float stepX = (gyy * bx - gxy * by) / determinant;
+            const float stepY = (gxx * by - gxy * bx) / determinant;
+
+            flowX += stepX;
+            flowY += stepY;
+
+            if (stepX * stepX + stepY * stepY < options->epsilon * options->epsilon)
+                break;
+        }
+
+        if (level == 0)
+        {
+            SamplePatch(next->image, next->imageSize, x + guessX + flowX, y + guessY + flowY, radius, 1.0f, movingPatch);
+
+            for (int index = 0; index < patchCount; ++index)
+                residual += fabsf(templatePatch[index] - movingPatch[index]);
+            residual /= patchCount;
+        }
+
+        guessX = (level == 0) ? (guessX + flowX) : (2.0f * (guessX + flowX));
+        guessY = (level == 0) ? (guessY + flowY) : (2.0f * (guessY + flowY));
+    }
+
+    const SIZE imageSize = nextPyramid->levels[0].imageSize;
+
+    nextPoint->x   = previousPoint->x + guessX;
+    nextPoint->y   = previousPoint->y + guessY;
+    nextPoint->id  = previousPoint->id;
+    nextPoint->age = previousPoint->age + 1;
+
+    return nextPoint->x >= radius && nextPoint->y >= radius && nextPoint->x < imageSize.cx - radius - 1 && nextPoint->y < imageSize.cy - radius - 1 &&
+           residual <= options->maxResidual;
+}
+
+// Tracks the points of the previous frame into the next one, in contiguous batches of points per thread.
+// tracked tells which points were found; the return value is how many.
+size_t TrackPyramidPoints(ImagePyramid* previousPyramid, ImagePyramid* nextPyramid, const TrackedPoint* previousPoints, TrackedPoint* nextPoints, bool* tracked, const size_t pointCount, const FeatureTrackerOptions* options)
+{
+    assert(previousPyramid != NULL);
+    assert(nextPyramid     != NULL);
+    assert(options         != NULL);
+    assert(options->patchRadius > 0 && options->patchRadius <= MAX_TRACKER_PATCH_RADIUS);
+    assert(options->levelCount <= previousPyramid->levelCount && options->levelCount <= nextPyramid->levelCount);
+
+    // The lazily built levels must all exist before the threads read them.
+    for (int level = 0; level < options->levelCount; ++level)
+    {
+        RequirePyramidLevel(previousPyramid, level, PYRAMID_IMAGE | PYRAMID_GRADIENT);
+        RequirePyramidLevel(nextPyramid, level, PYRAMID_IMAGE);
+    }
+
+    const int hardwareThreadCount = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    const int threadCount         = static_cast<int>(std::min<size_t>(std::max<size_t>(pointCount, 1), (options->threadCount > 0) ? (options->threadCount) : (hardwareThreadCount)));
+
+    RunReductionThreads(threadCount, [&](int thread) {
+        const size_t begin = pointCount * thread / threadCount;
+        const size_t end   = pointCount * (thread + 1) / threadCount;
+
+        for (size_t index = begin; index < end; ++index)
+            tracked[index] = TrackPyramidPoint(previousPyramid, nextPyramid, &previousPoints[index], &nextPoints[index], options);
+    });
+
+    return static_cast<size_t>(std::count(tracked, tracked + pointCount, true));
+}
+
+FeatureTracker* CreateFeatureTracker(SIZE imageSize, const FeatureTrackerOptions* options)
+{
+    assert(options != NULL);
+    assert(options->patchRadius > 0 && options->patchRadius <= MAX_TRACKER_PATCH_RADIUS);
+    assert(options->maxTrackCount > 0);
+
+    FeatureTracker* tracker = new FeatureTracker;
+
+    tracker->options      = *options;
+    tracker->imageSize    = imageSize;
+    tracker->frames[0]    = new byte_t[imageSize.cx * imageSize.cy];
+    tracker->frames[1]    = new byte_t[imageSize.cx * imageSize.cy];
+    tracker->currentFrame = 0;
+    tracker->pyramid      = NULL;
+    tracker->points       = new TrackedPoint[options->maxTrackCount];
+    tracker->pointCount   = 0;
+    tracker->nextId       = 0;
+    tracker->redetected   = false;
+
+    tracker->options.levelCount = std::min(options->levelCount, CalculatePyramidLevelCount(imageSize, options->levelCount, 2 * options->patchRadius + 2));
+
+    return tracker;
+}
+
+void ReleaseFeatureTracker(FeatureTracker* tracker)
+{
+    assert(tracker != NULL);
+
+    ReleaseImagePyramid(tracker->pyramid);
+
+    delete[] tracker->frames[0];
+    delete[] tracker->frames[1];
+    delete[] tracker->points;
+
+    delete tracker;
+}
+
+// Adds Harris corners of the current frame, strongest first, that are at least minDistance from each other
+// and from every tracked point, until maxTrackCount points are tracked. Corners are ranked by the smaller
+// eigenvalue of the structure tensor averaged over the tracking patch, the tensor TrackPyramidPoint solves
+// with, and dropped when tracking would reject them. Its diagonal comes from the integral images the Harris
+// response uses; the off-diagonal must keep the sign of gx * gy, which the Harris |gx| * |gy| integral drops,
+// so it is summed from its own integral image. Returns the number of points added.
+int DetectTrackerFeatures(FeatureTracker* tracker)
+{
+    assert(tracker          != NULL);
+    assert(tracker->pyramid != NULL);
+
+    const FeatureTrackerOptions& options     = tracker->options;
+    const SIZE                   imageSize   = tracker->imageSize;
+    const int                    width       = imageSize.cx;
+    const int                    height      = imageSize.cy;
+    const int                    border      = options.patchRadius + 1;
+    const SIZE                   patchSize   = { 2 * options.patchRadius + 1, 2 * options.patchRadius + 1 };
+    const float                  tensorScale = SOBEL_GRADIENT_SCALE * SOBEL_GRADIENT_SCALE;
+    const int                    cellSize    = std::max(static_cast<int>(options.minDistance / sqrtf(2.0f)), 1);
+    const int                    gridReach   = (options.minDistance - 1) / cellSize + 1;
+    const int                    gridWidth   = (width + cellSize - 1) / cellSize;
+    const int                    gridHeight  = (height + cellSize - 1) / cellSize;
+    const int                    capacity    = options.maxTrackCount - tracker->pointCount;
+
+    if (capacity <= 0)
+        return 0;
+
+    const PyramidLevel* level           = RequirePyramidLevel(tracker->pyramid, 0, PYRAMID_GRADIENT | PYRAMID_STRUCTURE_TENSOR);
+    const RECT          frameRect       = { 0, 0, width, height };
+    byte_t*             cornerImage     = new byte_t[width * height];
+    int*                grid            = new int[gridWidth * gridHeight];
+    mag_t*              productImage    = new mag_t[width * height];
+    int64_t*            integralImageXY = new int64_t[(width + 1) * (height + 1)];
+
+    std::vector<std::pair<float, int>> candidates;
+    std::vector<POINT>                 selected;
+
+    EvaluateHarrisResponse(level->integralImagePowX, level->integralImagePowY, level->integralImageXY, cornerImage, imageSize, options.harrisWsize, options.lamda, NULL);
+
+    for (int index = 0; index < tracker->pointCount; ++index)
+    {
+        const int cx     = static_cast<int>(tracker->points[index].x + 0.5f);
+        const int cy     = static_cast<int>(tracker->points[index].y + 0.5f);
+        const int left   = std::max(cx - options.minDistance + 1, 0);
+        const int right  = std::min(cx + options.minDistance, width);
+
+        for (int iy = std::max(cy - options.minDistance + 1, 0); iy < std::min(cy + options.minDistance, height) && left < right; ++iy)
+            memset(cornerImage + iy * width + left, 0, sizeof(byte_t) * (right - left));
+    }
+
+    for (int index = 0; index < width * height; ++index)
+        productImage[index] = level->magnitudeX[index] * level->magnitudeY[index];
+
+    CreateRegionIntegralImage(productImage, integralImageXY, imageSize, frameRect);
+
+    for (int iy = border; iy < height - border; ++iy)
+        for (int ix = border; ix < width - border; ++ix)
+        {
+            if (cornerImage[iy * width + ix] == 0)
+                continue;
+
+            const float gxx           = static_cast<float>(CalculateIntegralWindowAverage(level->integralImagePowX, imageSize, { ix, iy }, patchSize)) * tensorScale;
+            const float gyy           = static_cast<float>(CalculateIntegralWindowAverage(level->integralImagePowY, imageSize, { ix, iy }, patchSize)) * tensorScale;
+            const float gxy           = static_cast<float>(CalculateRegionWindowAverage(integralImageXY, frameRect, { ix, iy }, patchSize)) * tensorScale;
+            const float minEigenvalue = (gxx + gyy - sqrtf((gxx - gyy) * (gxx - gyy) + 4.0f * gxy * gxy)) / 2.0f;
+
+            if (minEigenvalue >= options.minEigenvalue)
+                candidates.push_back(std::make_pair(-minEigenvalue, iy * width + ix));
+        }
+
+    std::sort(candidates.begin(), candidates.end());
+    std::fill(grid, grid + gridWidth * gridHeight, -1);
+
+    // The neighborhoods of the tracked points are masked out above, so the grid only holds new corners. Cells are
+    // minDistance / sqrt(2) wide, so their diagonal is shorter than minDistance and each holds at most one
+    // corner; a corner closer than minDistance lies within gridReach cells of the candidate.
+    for (size_t index = 0; index < candidates.size() && static_cast<int>(selected.size()) < capacity; ++index)
+    {
+        const int x        = candidates[index].second % width;
+        const int y        = candidates[index].second / width;
+        const int gx       = x / cellSize;
+        const int gy       = y / cellSize;
+        bool      accepted = true;
+
+        for (int ny = std::max(gy - gridReach, 0); ny <= std::min(gy + gridReach, gridHeight - 1) && accepted; ++ny)
+            for (int nx = std::max(gx - gridReach, 0); nx <= std::min(gx + gridReach, gridWidth - 1) && accepted; ++nx)
+            {
+                const int neighbor = grid[ny * gridWidth + nx];
+
+                if (neighbor >= 0 && (selected[neighbor].x - x) * (selected[neighbor].x - x) + (selected[neighbor].y - y) * (selected[neighbor].y - y) < options.minDistance * options.minDistance)
+                    accepted = false;
+            }
+
+        if (!accepted)
+            continue;
+
+        grid[gy * gridWidth + gx] = static_cast<int>(selected.size());
+        selected.push_back({ x, y });
+
+        tracker->points[tracker->pointCount++] = { static_cast<float>(x), static_cast<float>(y), tracker->nextId++, 0 };
+    }
+
+    delete[] cornerImage;
+    delete[] grid;
+    delete[] productImage;
+    delete[] integralImageXY;
+
+    return static_cast<int>(selected.size());
+}
+
+// Tracks the points of the last frame into inputImage, dropping the ones that are lost, and detects new
+// corners when too few or none remain. The first frame only detects. Returns the number of tracked points.
+int TrackFeatures(FeatureTracker* tracker, const byte_t* inputImage)
+{
+    assert(tracker    != NULL);
+    assert(inputImage != NULL);
+
+    const SIZE imageSize = tracker->imageSize;
+    byte_t*    frame     = tracker->frames[tracker->currentFrame];
+
+    memcpy(frame, inputImage, sizeof(byte_t) * imageSize.cx * imageSize.cy);
+
+    ImagePyramid* pyramid = CreateImagePyramid(frame, imageSize, tracker->options.levelCount);
+
+    if (tracker->pyramid != NULL && tracker->pointCount > 0)
+    {
+        TrackedPoint* nextPoints = new TrackedPoint[tracker->pointCount];
+        bool*         tracked    = new bool[tracker->pointCount];
+        int           kept       = 0;
+
+        TrackPyramidPoints(tracker->pyramid, pyramid, tracker->points, nextPoints, tracked, tracker->pointCount, &tracker->options);
+
+        for (int index = 0; index < tracker->pointCount; ++index)
+            if (tracked[index])
+                tracker->points[kept++] = nextPoints[index];
+
+        tracker->pointCount = kept;
+
+        delete[] nextPoints;
+        delete[] tracked;
+    }
+
+    ReleaseImagePyramid(tracker->pyramid);
+
+    tracker->pyramid      = pyramid;
+    tracker->currentFrame = 1 - tracker->currentFrame;
+    tracker->redetected   = tracker->pointCount == 0 || tracker->pointCount < tracker->options.minTrackCount;
+
+    if (tracker->redetected)
+        DetectTrackerFeatures(tracker);
+
+    return tracker->pointCount;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,70 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Pyramid.h"
+
+#include <cstddef>
+
+// +------------------------------------------< FEATURE TRACKER >-------------------------------------------+
+
+// levelCount pyramid levels are tracked coarse to fine with a (2 * patchRadius + 1)^2 patch, iterating at
+// most maxIterationCount times per level or until a step is below epsilon pixels. A point is lost when its
+// patch is too flat (the smaller structure tensor eigenvalue per pixel below minEigenvalue), when it leaves the
+// image or when the mean absolute patch difference exceeds maxResidual. Corners are detected again, with
+// HarrisCorner's window and lamda, whenever fewer than minTrackCount points remain, up to maxTrackCount points
+// minDistance apart. threadCount 0 uses every hardware thread.
+struct FeatureTrackerOptions
+{
+    int    levelCount;
+    int    patchRadius;
+    int    maxIterationCount;
+    double epsilon;
+    double minEigenvalue;
+    double maxResidual;
+    int    minTrackCount;
+    int    maxTrackCount;
+    int    minDistance;
+    int    harrisWsize;
+    double lamda;
+    int    threadCount;
+};
+
+static const FeatureTrackerOptions DEFAULT_FEATURE_TRACKER_OPTIONS = { 3, 7, 10, 0.03, 1.0, 24.0, 200, 500, 8, 3, 0.05, 0 };
+
+// id follows a point from the frame it was detected in; age counts the frames it has been tracked over.
+struct TrackedPoint
+{
+    float x;
+    float y;
+    int   id;
+    int   age;
+};
+
+// The pyramid of the last frame is kept with its Sobel gradients, which the next frame is tracked against and
+// which the corner detection of that frame shares through the pyramid's structure tensor.
+struct FeatureTracker
+{
+    FeatureTrackerOptions options;
+    SIZE                  imageSize;
+
+    byte_t*               frames[2];
+    int                   currentFrame;
+    ImagePyramid*         pyramid;
+
+    TrackedPoint*         points;
+    int                   pointCount;
+    int                   nextId;
+    bool                  redetected;
+};
+
+FeatureTracker* CreateFeatureTracker(SIZE imageSize, const FeatureTrackerOptions* options = &DEFAULT_FEATURE_TRACKER_OPTIONS);
+void            ReleaseFeatureTracker(FeatureTracker* tracker);
+int             TrackFeatures(FeatureTracker* tracker, const byte_t* inputImage);
+int             DetectTrackerFeatures(FeatureTracker* tracker);
+size_t          TrackPyramidPoints(ImagePyramid* previousPyramid, ImagePyramid* nextPyramid, const TrackedPoint* previousPoints, TrackedPoint* nextPoints, bool* tracked, const size_t pointCount, const FeatureTrackerOptions* options);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,765 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Harris Corner Detector.h"
+#include "Convolution.h"
+#include "Sobel.h"
+#include "Utility.h"
+
+#if defined(__AVX2__)
+    #include <immintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+    #include <intrin.h>
+#endif
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+
+// +-------------------------------------------< HARRIS CORNER >--------------------------------------------+
+
+byte_t* HarrisCorner(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda)
+{
+    return HarrisCorner(inputImage, outputImage, imageSize, wsize, lamda, NULL);
+}
+
+// With a tileMask (TILE_SIZE tiles, as laid out by CalculateTileCount) the corner response is only evaluated in
+// the selected tiles; the others report no corners.
+byte_t* HarrisCorner(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda, const bool* tileMask, DensityIndex* densityIndex)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(wsize % 2   == 1);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    mag_t*   magnitudeX        = new mag_t[width * height];
+    mag_t*   magnitudeY        = new mag_t[width * height];
+
+    lbyte_t* integralImagePowX = new lbyte_t[width * height];
+    lbyte_t* integralImagePowY = new lbyte_t[width * height];
+    lbyte_t* integralImageXY   = new lbyte_t[width * height];
+
+    Sobel(inputImage, magnitudeX, imageSize, SOBEL_X);
+    Sobel(inputImage, magnitudeY, imageSize, SOBEL_Y);
+
+    CreateStructureTensorIntegrals(magnitudeX, magnitudeY, integralImagePowX, integralImagePowY, integralImageXY, imageSize);
+    EvaluateHarrisResponse(integralImagePowX, integralImagePowY, integralImageXY, outputImage, imageSize, wsize, lamda, tileMask, densityIndex);
+
+    delete[] magnitudeX;
+    delete[] magnitudeY;
+
+    delete[] integralImagePowX;
+    delete[] integralImagePowY;
+    delete[] integralImageXY;
+
+    return outputImage;
+}
+
+// Integral images of the gradient products gx^2, gy^2 and |gx||gy| the corner response averages over its
+// window; the sums wrap modulo 2^32, which the window differences undo.
+void CreateStructureTensorIntegrals(const mag_t* magnitudeX, const mag_t* magnitudeY, lbyte_t* integralImagePowX, lbyte_t* integralImagePowY, lbyte_t* integralImageXY, SIZE imageSize)
+{
+    assert(magnitudeX        != NULL);
+    assert(magnitudeY        != NULL);
+    assert(integralImagePowX != NULL);
+    assert(integralImagePowY != NULL);
+    assert(integralImageXY   != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    mag_t* productImage = new mag_t[width * height];
+
+    for (int index = 0; index < width * height; ++index)
+        productImage[index] = magnitudeX[index] * magnitudeX[index];
+    CreateIntegralImage(productImage, integralImagePowX, imageSize);
+
+    for (int index = 0; index < width * height; ++index)
+        productImage[index] = magnitudeY[index] * magnitudeY[index];
+    CreateIntegralImage(productImage, integralImagePowY, imageSize);
+
+    for (int index = 0; index < width * height; ++index)
+        productImage[index] = abs(magnitudeX[index]) * abs(magnitudeY[index]);
+    CreateIntegralImage(productImage, integralImageXY, imageSize);
+
+    delete[] productImage;
+}
+
+// Corners are set to 255.
+byte_t* EvaluateHarrisResponse(const lbyte_t* integralImagePowX, const lbyte_t* integralImagePowY, const lbyte_t* integralImageXY, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda, const bool* tileMask, DensityIndex* densityIndex)
+{
+    assert(integralImagePowX != NULL);
+    assert(integralImagePowY != NULL);
+    assert(integralImageXY   != NULL);
+    assert(outputImage       != NULL);
+    assert(wsize % 2         == 1);
+
+    const int  width     = imageSize.cx;
+    const int  height    = imageSize.cy;
+    const SIZE tileCount = CalculateTileCount(imageSize);
+
+    memset(outputImage, 0, sizeof(byte_t) * width * height);
+
+    if (densityIndex != NULL)
+        ResetDensityIndex(densityIndex, imageSize);
+
+    for (int iy = wsize / 2; iy < height - wsize / 2; ++iy)
+    {
+        for (int ix = wsize / 2; ix < width - wsize / 2; ++ix)
+        {
+            if (tileMask != NULL && !tileMask[(iy / TILE_SIZE) * tileCount.cx + ix / TILE_SIZE])
+                continue;
+
+            double sobelMagnitudeMeanPowX = CalculateIntegralWindowAverage(integralImagePowX, imageSize, { ix, iy }, { wsize, wsize });
+            double sobelMagnitudeMeanPowY = CalculateIntegralWindowAverage(integralImagePowY, imageSize, { ix, iy }, { wsize, wsize });
+            double sobelMagnitudeMeanXY   = CalculateIntegralWindowAverage(integralImageXY, imageSize, { ix, iy }, { wsize, wsize });
+
+            if ((sobelMagnitudeMeanPowX * sobelMagnitudeMeanPowY - pow(sobelMagnitudeMeanXY, 2) - lamda * pow(sobelMagnitudeMeanPowX + sobelMagnitudeMeanPowY, 2)) > 0.01)
+                outputImage[iy * width + ix] = 255;
+        }
+
+        if (densityIndex != NULL)
+            AccumulateDensityRow(densityIndex, outputImage + iy * width, iy, 255);
+    }
+
+    if (densityIndex != NULL)
+        FinishDensityIndex(densityIndex);
+
+    return outputImage;
+}
+
+// Corner maps of every pyramid level from the cached structure tensors, with the same window at each level so
+// that level l responds to corners 2^l times larger.
+ScaleSpaceMap* HarrisCornerPyramid(ImagePyramid* pyramid, const int wsize, const double lamda)
+{
+    assert(pyramid   != NULL);
+    assert(wsize % 2 == 1);
+
+    ScaleSpaceMap* map = CreateScaleSpaceMap(pyramid);
+
+    for (int level = 0; level < pyramid->levelCount; ++level)
+    {
+        const PyramidLevel* current = RequirePyramidLevel(pyramid, level, PYRAMID_STRUCTURE_TENSOR);
+
+        EvaluateHarrisResponse(current->integralImagePowX, current->integralImagePowY, current->integralImageXY, map->images[level], current->imageSize, wsize, lamda, NULL);
+    }
+
+    return map;
+}
+
+static const int    HARRIS_GAUSSIAN_STRIP_WIDTH = 256;
+static const double HARRIS_GAUSSIAN_HALO        = 8.0;
+
+// The structure tensor weighted by a Gaussian of the given sigma instead of a box window, evaluated in
+// vertical strips of HARRIS_GAUSSIAN_STRIP_WIDTH columns so that the tensor images are only as wide as a strip.
+// The Sobel gradients come from the tuned kernel a band of rows at a time, and their products are smoothed with
+// the recursive Gaussian in float: exactly down each column, and along each row over the strip widened by
+// HARRIS_GAUSSIAN_HALO sigmas, past which the row pass has forgotten where it started. The cost does not grow
+// with sigma.
+byte_t* HarrisCornerGaussian(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const double sigma, const double lamda)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const int                width     = imageSize.cx;
+    const int                height    = imageSize.cy;
+    const int                border    = std::max(1, static_cast<int>(ceil(HARRIS_GAUSSIAN_BORDER * sigma)));
+    const int                halo      = static_cast<int>(ceil(HARRIS_GAUSSIAN_HALO * sigma));
+    const int                maxWidth   = std::min(width, HARRIS_GAUSSIAN_STRIP_WIDTH + 2 * halo + 2);
+    const int                bandHeight = GetTuningProfile()->convolutionBandHeight;
+    const RecursiveGaussian  gaussian   = CreateRecursiveGaussian(sigma);
+    const ConvolutionKernel* kernelX    = SelectSobelKernel(SOBEL_X, GetTuningProfile()->sobelVariant);
+    const ConvolutionKernel* kernelY    = SelectSobelKernel(SOBEL_Y, GetTuningProfile()->sobelVariant);
+
+    mag_t* magnitudeX = new mag_t[maxWidth * (bandHeight + 2)];
+    mag_t* magnitudeY = new mag_t[maxWidth * (bandHeight + 2)];
+    float* tensorPowX = new float[maxWidth * height];
+    float* tensorPowY = new float[maxWidth * height];
+    float* tensorXY   = new float[maxWidth * height];
+
+    memset(outputImage, 0, sizeof(byte_t) * width * height);
+
+    for (int stripLeft = 0; stripLeft < width; stripLeft += HARRIS_GAUSSIAN_STRIP_WIDTH)
+    {
+        const int  stripRight = std::min(stripLeft + HARRIS_GAUSSIAN_STRIP_WIDTH, width);
+        const int  spanLeft   = std::max(stripLeft - halo, 0);
+        const int  spanRight  = std::min(stripRight + halo, width);
+        const int  spanWidth  = spanRight - spanLeft;
+        const int  readLeft   = std::max(spanLeft - 1, 0);
+        const int  readWidth  = std::min(spanRight + 1, width) - readLeft;
+        const SIZE spanSize   = { spanWidth, height };
+
+        for (int bandTop = 0; bandTop < height; bandTop += bandHeight)
+        {
+            const int  bandBottom = std::min(bandTop + bandHeight, height);
+            const int  readTop    = std::max(bandTop - 1, 0);
+            const SIZE readSize   = { readWidth, std::min(bandBottom + 1, height) - readTop };
+
+            // Only rows and columns with a full window get a gradient; the image border keeps zero gradients,
+            // as the full-frame Sobel leaves them.
+            memset(magnitudeX, 0, sizeof(mag_t) * readSize.cx * readSize.cy);
+            memset(magnitudeY, 0, sizeof(mag_t) * readSize.cx * readSize.cy);
+
+            ConvolveRegionRows([&](int iy) { return inputImage + (readTop + iy) * width + readLeft; }, magnitudeX, readSize, kernelX, { 0, 0, readSize.cx, readSize.cy });
+            ConvolveRegionRows([&](int iy) { return inputImage + (readTop + iy) * width + readLeft; }, magnitudeY, readSize, kernelY, { 0, 0, readSize.cx, readSize.cy });
+
+            for (int iy = bandTop; iy < bandBottom; ++iy)
+            {
+                const mag_t* gradientX = magnitudeX + (iy - readTop) * readSize.cx + (spanLeft - readLeft);
+                const mag_t* gradientY = magnitudeY + (iy - readTop) * readSize.cx + (spanLeft - readLeft);
+                float*       powX      = tensorPowX + iy * spanWidth;
+                float*       powY      = tensorPowY + iy * spanWidth;
+                float*       xy        = tensorXY + iy * spanWidth;
+
+                for (int ix = 0; ix < spanWidth; ++ix)
+                {
+                    powX[ix] = static_cast<float>(gradientX[ix] * gradientX[ix]);
+                    powY[ix] = static_cast<float>(gradientY[ix] * gradientY[ix]);
+                    xy[ix]   = static_cast<float>(abs(gradientX[ix]) * abs(gradientY[ix]));
+                }
+
+                FilterRecursiveGaussianRow(&gaussian, powX, spanWidth);
+                FilterRecursiveGaussianRow(&gaussian, powY, spanWidth);
+                FilterRecursiveGaussianRow(&gaussian, xy, spanWidth);
+            }
+        }
+
+        FilterRecursiveGaussianColumns(&gaussian, tensorPowX, spanSize);
+        FilterRecursiveGaussianColumns(&gaussian, tensorPowY, spanSize);
+        FilterRecursiveGaussianColumns(&gaussian, tensorXY, spanSize);
+
+        for (int iy = border; iy < height - border; ++iy)
+            for (int ix = std::max(stripLeft, border); ix < std::min(stripRight, width - border); ++ix)
+            {
+                const double meanPowX = tensorPowX[iy * spanWidth + ix - spanLeft];
+                const double meanPowY = tensorPowY[iy * spanWidth + ix - spanLeft];
+                const double meanXY   = tensorXY[iy * spanWidth + ix - spanLeft];
+
+                if ((meanPowX * meanPowY - pow(meanXY, 2) - lamda * pow(meanPowX + meanPowY, 2)) > 0.01)
+                    outputImage[iy * width + ix] = 255;
+            }
+    }
+
+    delete[] magnitudeX;
+    delete[] magnitudeY;
+    delete[] tensorPowX;
+    delete[] tensorPowY;
+    delete[] tensorXY;
+
+    return outputImage;
+}
+
+// +-----------------------------------------< BINARY DESCRIPTOR >------------------------------------------+
+
+static const int MATCH_QUERY_BLOCK     = 64;
+static const int MATCH_TRAIN_BLOCK     = 256;
+static const int MATCH_MIN_BLOCK_COUNT = 4;
+
+// 256 point pairs drawn from an isotropic Gaussian (sigma = patch size / 5) clipped to the patch circle, using
+// a fixed-seed generator so that descriptors are reproducible across runs and machines.
+BriefPattern CreateBriefPattern(void)
+{
+    BriefPattern pattern;
+    uint64_t     state = 0x9E3779B97F4A7C15ULL;
+    double       sigma = (2 * BRIEF_PATCH_RADIUS + 1) / 5.0;
+
+    for (int index = 0; index < BRIEF_PAIR_COUNT * 2; ++index)
+    {
+        POINT& point = pattern.points[index];
+
+        do
+        {
+            double uniform[2];
+
+            for (int component = 0; component < 2; ++component)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                uniform[component] = ((state >> 11) + 0.5) / 9007199254740992.0;
+            }
+
+            point.x = static_cast<LONG>(floor(sigma * sqrt(-2.0 * log(uniform[0])) * cos(2.0 * PI * uniform[1]) + 0.5));
+            point.y = static_cast<LONG>(floor(sigma * sqrt(-2.0 * log(uniform[0])) * sin(2.0 * PI * uniform[1]) + 0.5));
+        }
+        while (point.x * point.x + point.y * point.y > BRIEF_PATCH_RADIUS * BRIEF_PATCH_RADIUS ||
+               (index % 2 == 1 && point.x == pattern.points[index - 1].x && point.y == pattern.points[index - 1].y));
+    }
+
+    return pattern;
+}
+
+static const BriefPattern BRIEF_PATTERN = CreateBriefPattern();
+
+// Greedy raster-order selection of corner pixels that are at least minDistance apart and far enough from the
+// border for a descriptor patch. Grid cells are minDistance / sqrt(2) wide, so their diagonal is shorter than
+// minDistance and each holds at most one accepted corner; a closer corner lies within gridReach cells.
+size_t SelectCornerPoints(const byte_t* cornerImage, POINT* points, SIZE imageSize, const size_t maxPointCount, const int minDistance)
+{
+    assert(cornerImage != NULL);
+    assert(points      != NULL);
+    assert(minDistance > 0);
+
+    const int width      = imageSize.cx;
+    const int height     = imageSize.cy;
+    const int cellSize   = std::max(static_cast<int>(minDistance / sqrt(2.0)), 1);
+    const int gridReach  = (minDistance - 1) / cellSize + 1;
+    const int gridWidth  = (width + cellSize - 1) / cellSize;
+    const int gridHeight = (height + cellSize - 1) / cellSize;
+
+    int*   grid       = new int[gridWidth * gridHeight];
+    size_t pointCount = 0;
+
+    std::fill(grid, grid + gridWidth * gridHeight, -1);
+
+    for (int iy = BRIEF_BORDER; iy < height - BRIEF_BORDER && pointCount < maxPointCount; ++iy)
+        for (int ix = BRIEF_BORDER; ix < width - BRIEF_BORDER && pointCount < maxPointCount; ++ix)
+        {
+            if (cornerImage[iy * width + ix] == 0)
+                continue;
+
+            const int gx       = ix / cellSize;
+            const int gy       = iy / cellSize;
+            bool      accepted = true;
+
+            for (int ny = std::max(gy - gridReach, 0); ny <= std::min(gy + gridReach, gridHeight - 1) && accepted; ++ny)
+                for (int nx = std::max(gx - gridReach, 0); nx <= std::min(gx + gridReach, gridWidth - 1) && accepted; ++nx)
+                {
+                    int neighbor = grid[ny * gridWidth + nx];
+
+                    if (neighbor >= 0 && (points[neighbor].x - ix) * (points[neighbor].x - ix) + (points[neighbor].y - iy) * (points[neighbor].y - iy) < minDistance * minDistance)
+                        accepted = false;
+                }
+
+            if (!accepted)
+                continue;
+
+            grid[gy * gridWidth + gx] = static_cast<int>(pointCount);
+            points[pointCount++]      = { ix, iy };
+        }
+
+    delete[] grid;
+
+    return pointCount;
+}
+
+// Intensity centroid orientation of the patch, as used by ORB to steer the test pattern.
+double CalculatePatchOrientation(const byte_t* inputImage, SIZE imageSize, POINT center)
+{
+    assert(inputImage != NULL);
+
+    const int width = imageSize.cx;
+
+    double momentX = 0.0;
+    double momentY = 0.0;
+
+    for (int wy = -BRIEF_PATCH_RADIUS; wy <= BRIEF_PATCH_RADIUS; ++wy)
+        for (int wx = -BRIEF_PATCH_RADIUS; wx <= BRIEF_PATCH_RADIUS; ++wx)
+            if (wx * wx + wy * wy <= BRIEF_PATCH_RADIUS * BRIEF_PATCH_RADIUS)
+            {
+                momentX += wx * inputImage[(center.y + wy) * width + (center.x + wx)];
+                momentY += wy * inputImage[(center.y + wy) * width + (center.x + wx)];
+            }
+
+    return atan2(momentY, momentX);
+}
+
+// SelectCornerPoints on every level of a corner map, finest first, with the minimum distance measured in
+// level pixels; point is the level 0 position of the corner and levelPoint its position in its own level.
+size_t SelectScaleSpaceCorners(const ScaleSpaceMap* cornerMap, ScaleSpacePoint* points, const size_t maxPointCount, const int minDistance)
+{
+    assert(cornerMap != NULL);
+    assert(points    != NULL);
+
+    size_t pointCount  = 0;
+    POINT* levelPoints = new POINT[maxPointCount];
+
+    for (int level = 0; level < cornerMap->levelCount && pointCount < maxPointCount; ++level)
+    {
+        const size_t levelCount = SelectCornerPoints(cornerMap->images[level], levelPoints, cornerMap->imageSizes[level], maxPointCount - pointCount, minDistance);
+
+        for (size_t index = 0; index < levelCount; ++index)
+        {
+            points[pointCount].levelPoint = levelPoints[index];
+            points[pointCount].point      = { levelPoints[index].x * cornerMap->scales[level], levelPoints[index].y * cornerMap->scales[level] };
+            points[pointCount].level      = level;
+
+            ++pointCount;
+        }
+    }
+
+    delete[] levelPoints;
+
+    return pointCount;
+}
+
+// Steered BRIEF: each bit compares two Gaussian smoothed pixels of the pattern rotated to the patch orientation.
+// Points must lie at least BRIEF_BORDER pixels inside the image, as returned by SelectCornerPoints.
+BinaryDescriptor* ExtractBinaryDescriptors(const byte_t* inputImage, SIZE imageSize, const POINT* points, const size_t pointCount, BinaryDescriptor* descriptors, const bool oriented)
+{
+    assert(inputImage  != NULL);
+    assert(points      != NULL);
+    assert(descriptors != NULL);
+
+    static const ConvolutionKernel SMOOTHING_KERNEL = CreateGaussianKernel(2.0);
+
+    const int    width         = imageSize.cx;
+    const int    height        = imageSize.cy;
+    const POINT* pattern       = BRIEF_PATTERN.points;
+    float*       smoothedImage = new float[width * height];
+
+    Convolve(inputImage, smoothedImage, imageSize, &SMOOTHING_KERNEL);
+
+    for (size_t index = 0; index < pointCount; ++index)
+    {
+        assert(points[index].x >= BRIEF_BORDER && points[index].x < width - BRIEF_BORDER);
+        assert(points[index].y >= BRIEF_BORDER && points[index].y < height - BRIEF_BORDER);
+
+        const float* patch  = smoothedImage + points[index].y * width + points[index].x;
+        double       angle  = oriented ? CalculatePatchOrientation(inputImage, imageSize, points[index]) : 0.0;
+        double       cosine = cos(angle);
+        double       sine   = sin(angle);
+
+        memset(&descriptors[index], 0, sizeof(BinaryDescriptor));
+
+        for (int pair = 0; pair < BRIEF_PAIR_COUNT; ++pair)
+        {
+            POINT first  = pattern[pair * 2];
+            POINT second = pattern[pair * 2 + 1];
+
+            int firstX  = static_cast<int>(floor(cosine * first.x - sine * first.y + 0.5));
+            int firstY  = static_cast<int>(floor(sine * first.x + cosine * first.y + 0.5));
+            int secondX = static_cast<int>(floor(cosine * second.x - sine * second.y + 0.5));
+            int secondY = static_cast<int>(floor(sine * second.x + cosine * second.y + 0.5));
+
+            if (patch[firstY * width + firstX] < patch[secondY * width + secondX])
+                descriptors[index].bits[pair / 64] |= 1ULL << (pair % 64);
+        }
+    }
+
+    delete[] smoothedImage;
+
+    return descriptors;
+}
+
+// +------------------------------------------< DESCRIPTOR MATCH >------------------------------------------+
+
+int CountBits(uint64_t value)
+{
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt64(value));
+#elif defined(__POPCNT__)
+    return __builtin_popcountll(value);
+#else
+    value = value - ((value >> 1) & 0x5555555555555555ULL);
+    value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+    value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+    return static_cast<int>((value * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+// With AVX2 the 256-bit difference is counted in one register with a nibble lookup (vpshufb) and a horizontal
+// byte sum (vpsadbw); otherwise with four hardware popcounts.
+int CalculateHammingDistance(const BinaryDescriptor* first, const BinaryDescriptor* second)
+{
+#if defined(__AVX2__)
+    const __m256i nibbleCount = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4, 0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibbleMask  = _mm256_set1_epi8(0x0F);
+
+    __m256i difference = _mm256_xor_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(first->bits)), _mm256_loadu_si256(reinterpret_cast<const __m256i*>(second->bits)));
+    __m256i lowCount   = _mm256_shuffle_epi8(nibbleCount, _mm256_and_si256(difference, nibbleMask));
+    __m256i highCount  = _mm256_shuffle_epi8(nibbleCount, _mm256_and_si256(_mm256_srli_epi16(difference, 4), nibbleMask));
+    __m256i laneCount  = _mm256_sad_epu8(_mm256_add_epi8(lowCount, highCount), _mm256_setzero_si256());
+    __m128i halfCount  = _mm_add_epi64(_mm256_castsi256_si128(laneCount), _mm256_extracti128_si256(laneCount, 1));
+
+    return _mm_cvtsi128_si32(_mm_add_epi64(halfCount, _mm_unpackhi_epi64(halfCount, halfCount)));
+#else
+    int distance = 0;
+
+    for (int word = 0; word < BRIEF_PAIR_COUNT / 64; ++word)
+        distance += CountBits(first->bits[word] ^ second->bits[word]);
+
+    return distance;
+#endif
+}
+
+// Brute-force nearest neighbors for the queries [queryBegin, queryEnd). Queries are processed in blocks of
+// MATCH_QUERY_BLOCK against train blocks of MATCH_TRAIN_BLOCK descriptors (8 KB), so both working sets stay in
+// L1 while every pair of the two blocks is compared.
+void MatchBinaryDescriptorRange(const BinaryDescriptor* queryDescriptors, size_t queryBegin, size_t queryEnd, const BinaryDescriptor* trainDescriptors, size_t trainCount, DescriptorMatch* matches)
+{
+    for (size_t query = queryBegin; query < queryEnd; ++query)
+    {
+        matches[query].trainIndex     = -1;
+        matches[query].distance       = BRIEF_PAIR_COUNT + 1;
+        matches[query].secondDistance = BRIEF_PAIR_COUNT + 1;
+    }
+
+    for (size_t queryBlock = queryBegin; queryBlock < queryEnd; queryBlock += MATCH_QUERY_BLOCK)
+        for (size_t trainBlock = 0; trainBlock < trainCount; trainBlock += MATCH_TRAIN_BLOCK)
+        {
+            const size_t queryBlockEnd = std::min(queryBlock + MATCH_QUERY_BLOCK, queryEnd);
+            const size_t trainBlockEnd = std::min(trainBlock + MATCH_TRAIN_BLOCK, trainCount);
+
+            for (size_t query = queryBlock; query < queryBlockEnd; ++query)
+            {
+                DescriptorMatch match = matches[query];
+
+                for (size_t train = trainBlock; train < trainBlockEnd; ++train)
+                {
+                    int distance = CalculateHammingDistance(&queryDescriptors[query], &trainDescriptors[train]);
+
+                    if (distance < match.distance)
+                    {
+                        match.secondDistance = match.distance;
+                        match.distance       = distance;
+                        match.trainIndex     = static_cast<int>(train);
+                    }
+                    else if (distance < match.secondDistance)
+                        match.secondDistance = distance;
+                }
+
+                matches[query] = match;
+            }
+        }
+}
+
+// matches[i] receives the nearest train descriptor of query i together with the second nearest distance for a
+// ratio test. Large query sets are split into contiguous ranges matched on threadCount threads, 0 taking the
+// thread count of the tuning profile.
+DescriptorMatch* MatchBinaryDescriptors(const BinaryDescriptor* queryDescriptors, const size_t queryCount, const BinaryDescriptor* trainDescriptors, const size_t trainCount, DescriptorMatch* matches, int threadCount)
+{
+    assert(queryDescriptors != NULL || queryCount == 0);
+    assert(trainDescriptors != NULL || trainCount == 0);
+    assert(matches          != NULL || queryCount == 0);
+
+    if (threadCount <= 0)
+        threadCount = SelectThreadCount();
+
+    threadCount = std::min<int>(threadCount, static_cast<int>((queryCount + MATCH_QUERY_BLOCK - 1) / MATCH_QUERY_BLOCK));
+
+    if (threadCount <= 1 || queryCount * trainCount < MATCH_MIN_BLOCK_COUNT * MATCH_QUERY_BLOCK * MATCH_TRAIN_BLOCK)
+    {
+        MatchBinaryDescriptorRange(queryDescriptors, 0, queryCount, trainDescriptors, trainCount, matches);
+
+        return matches;
+    }
+
+    std::thread* threads    = new std::thread[threadCount];
+    size_t       blockCount = (queryCount + MATCH_QUERY_BLOCK - 1) / MATCH_QUERY_BLOCK;
+
+    for (int thread = 0; thread < threadCount; ++thread)
+    {
+        size_t queryBegin = std::min(queryCount, blockCount * thread / threadCount * MATCH_QUERY_BLOCK);
+        size_t queryEnd   = std::min(queryCount, blockCount * (thread + 1) / threadCount * MATCH_QUERY_BLOCK);
+
+        threads[thread] = std::thread(MatchBinaryDescriptorRange, queryDescriptors, queryBegin, queryEnd, trainDescriptors, trainCount, matches);
+    }
+
+    for (int thread = 0; thread < threadCount; ++thread)
+        threads[thread].join();
+
+    delete[] threads;
+
+    return matches;
+}
+
+// +-------------------------------------< INCREMENTAL HARRIS CORNER >--------------------------------------+
+
+HarrisIncrementalCache* CreateHarrisIncrementalCache(SIZE imageSize, const int wsize, const double lamda)
+{
+    assert(wsize % 2 == 1);
+
+    const int    width        = imageSize.cx;
+    const int    height       = imageSize.cy;
+    const SIZE   tileCount    = CalculateTileCount(imageSize);
+    const size_t integralSize = (TILE_SIZE + 2 * (wsize / 2 + 1) + wsize) * (TILE_SIZE + 2 * (wsize / 2 + 1) + wsize);
+
+    HarrisIncrementalCache* cache = new HarrisIncrementalCache;
+
+    cache->initialized        = false;
+    cache->imageSize          = imageSize;
+    cache->tileCount          = tileCount;
+    cache->wsize              = wsize;
+    cache->lamda              = lamda;
+    cache->previousImage      = new byte_t[width * height];
+    cache->sobelMagnitudeX    = new mag_t[width * height];
+    cache->sobelMagnitudeY    = new mag_t[width * height];
+    cache->sobelMagnitudePowX = new mag_t[width * height];
+    cache->sobelMagnitudePowY = new mag_t[width * height];
+    cache->sobelMagnitudeXY   = new mag_t[width * height];
+    cache->cornerImage        = new byte_t[width * height];
+    cache->dirtyTiles         = new bool[tileCount.cx * tileCount.cy];
+    cache->integralImagePowX  = new int64_t[integralSize];
+    cache->integralImagePowY  = new int64_t[integralSize];
+    cache->integralImageXY    = new int64_t[integralSize];
+
+    memset(cache->sobelMagnitudePowX, 0, sizeof(mag_t) * width * height);
+    memset(cache->sobelMagnitudePowY, 0, sizeof(mag_t) * width * height);
+    memset(cache->sobelMagnitudeXY, 0, sizeof(mag_t) * width * height);
+    memset(cache->cornerImage, 0, sizeof(byte_t) * width * height);
+
+    return cache;
+}
+
+void ReleaseHarrisIncrementalCache(HarrisIncrementalCache* cache)
+{
+    assert(cache != NULL);
+
+    delete[] cache->previousImage;
+    delete[] cache->sobelMagnitudeX;
+    delete[] cache->sobelMagnitudeY;
+    delete[] cache->sobelMagnitudePowX;
+    delete[] cache->sobelMagnitudePowY;
+    delete[] cache->sobelMagnitudeXY;
+    delete[] cache->cornerImage;
+    delete[] cache->dirtyTiles;
+
+    delete[] cache->integralImagePowX;
+    delete[] cache->integralImagePowY;
+    delete[] cache->integralImageXY;
+
+    delete cache;
+}
+
+int64_t* CreateRegionIntegralImage(const mag_t* inputImage, int64_t* integralImage, SIZE imageSize, RECT region)
+{
+    assert(inputImage    != NULL);
+    assert(integralImage != NULL);
+
+    const int width         = imageSize.cx;
+    const int integralWidth = region.right - region.left + 1;
+
+    memset(integralImage, 0, sizeof(int64_t) * integralWidth);
+
+    for (int iy = region.top; iy < region.bottom; ++iy)
+    {
+        int64_t* integralRow = integralImage + (iy - region.top + 1) * integralWidth;
+        int64_t  rowSum      = 0;
+
+        integralRow[0] = 0;
+
+        for (int ix = region.left; ix < region.right; ++ix)
+        {
+            rowSum += inputImage[iy * width + ix];
+            integralRow[ix - region.left + 1] = integralRow[ix - region.left + 1 - integralWidth] + rowSum;
+        }
+    }
+
+    return integralImage;
+}
+
+double CalculateRegionWindowAverage(const int64_t* integralImage, RECT region, POINT center, SIZE wsize)
+{
+    assert(integralImage != NULL);
+    assert(center.x - wsize.cx / 2 >= region.left && center.x + wsize.cx / 2 < region.right);
+    assert(center.y - wsize.cy / 2 >= region.top && center.y + wsize.cy / 2 < region.bottom);
+
+    const int integralWidth = region.right - region.left + 1;
+    const int left          = center.x - wsize.cx / 2 - region.left;
+    const int top           = center.y - wsize.cy / 2 - region.top;
+    const int right         = left + wsize.cx;
+    const int bottom        = top + wsize.cy;
+
+    int64_t integralSum = integralImage[bottom * integralWidth + right] - integralImage[bottom * integralWidth + left] - integralImage[top * integralWidth + right] + integralImage[top * integralWidth + left];
+
+    return static_cast<double>(integralSum / (wsize.cx * wsize.cy));
+}
+
+// Equivalent to HarrisCorner with the window size and lamda the cache was created with. The Sobel products are
+// cached for the whole frame; a changed tile refreshes them within the one pixel Sobel halo and re-evaluates
+// the corner response within a further half window, using integral images local to that neighborhood instead
+// of the three full-frame ones.
+byte_t* HarrisCornerIncremental(HarrisIncrementalCache* cache, const byte_t* inputImage, byte_t* outputImage)
+{
+    assert(cache       != NULL);
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const SIZE imageSize    = cache->imageSize;
+    const SIZE tileCount    = cache->tileCount;
+    const int  width        = imageSize.cx;
+    const int  wsize        = cache->wsize;
+    const RECT sobelRect    = { 1, 1, imageSize.cx - 1, imageSize.cy - 1 };
+    const SIZE sobelHalo    = { 1, 1 };
+    const RECT responseRect = { wsize / 2, wsize / 2, imageSize.cx - wsize / 2, imageSize.cy - wsize / 2 };
+    const SIZE responseHalo = { wsize / 2 + 1, wsize / 2 + 1 };
+
+    bool*  dirtyTiles     = cache->dirtyTiles;
+    size_t dirtyTileCount = tileCount.cx * tileCount.cy;
+
+    if (cache->initialized)
+        dirtyTileCount = FindDirtyTiles(cache->previousImage, inputImage, imageSize, dirtyTiles);
+    else
+        std::fill(dirtyTiles, dirtyTiles + tileCount.cx * tileCount.cy, true);
+
+    if (dirtyTileCount != 0)
+    {
+        for (int ty = 0; ty < tileCount.cy; ++ty)
+            for (int tx = 0; tx < tileCount.cx; ++tx)
+            {
+                if (!dirtyTiles[ty * tileCount.cx + tx])
+                    continue;
+
+                RECT region = CalculateTileRect(tx, ty, sobelHalo, sobelRect);
+
+                ConvolveRegion(inputImage, cache->sobelMagnitudeX, imageSize, SelectSobelKernel(SOBEL_X, GetTuningProfile()->sobelVariant), region);
+                ConvolveRegion(inputImage, cache->sobelMagnitudeY, imageSize, SelectSobelKernel(SOBEL_Y, GetTuningProfile()->sobelVariant), region);
+
+                for (int iy = region.top; iy < region.bottom; ++iy)
+                    for (int ix = region.left; ix < region.right; ++ix)
+                    {
+                        mag_t sobelMagnitudeX = cache->sobelMagnitudeX[iy * width + ix];
+                        mag_t sobelMagnitudeY = cache->sobelMagnitudeY[iy * width + ix];
+
+                        cache->sobelMagnitudeXY[iy * width + ix]   = abs(sobelMagnitudeX) * abs(sobelMagnitudeY);
+                        cache->sobelMagnitudePowX[iy * width + ix] = sobelMagnitudeX * sobelMagnitudeX;
+                        cache->sobelMagnitudePowY[iy * width + ix] = sobelMagnitudeY * sobelMagnitudeY;
+                    }
+
+                CopyTile(inputImage, cache->previousImage, imageSize, tx, ty);
+            }
+
+        for (int ty = 0; ty < tileCount.cy; ++ty)
+            for (int tx = 0; tx < tileCount.cx; ++tx)
+            {
+                if (!dirtyTiles[ty * tileCount.cx + tx])
+                    continue;
+
+                RECT region = CalculateTileRect(tx, ty, responseHalo, responseRect);
+
+                if (region.left >= region.right || region.top >= region.bottom)
+                    continue;
+
+                RECT window = { region.left - wsize / 2, region.top - wsize / 2, region.right + wsize / 2, region.bottom + wsize / 2 };
+
+                CreateRegionIntegralImage(cache->sobelMagnitudePowX, cache->integralImagePowX, imageSize, window);
+                CreateRegionIntegralImage(cache->sobelMagnitudePowY, cache->integralImagePowY, imageSize, window);
+                CreateRegionIntegralImage(cache->sobelMagnitudeXY, cache->integralImageXY, imageSize, window);
+
+                for (int iy = region.top; iy < region.bottom; ++iy)
+                    for (int ix = region.left; ix < region.right; ++ix)
+                    {
+                        double sobelMagnitudeMeanPowX = CalculateRegionWindowAverage(cache->integralImagePowX, window, { ix, iy }, { wsize, wsize });
+                        double sobelMagnitudeMeanPowY = CalculateRegionWindowAverage(cache->integralImagePowY, window, { ix, iy }, { wsize, wsize });
+                        double sobelMagnitudeMeanXY   = CalculateRegionWindowAverage(cache->integralImageXY, window, { ix, iy }, { wsize, wsize });
+
+                        if ((sobelMagnitudeMeanPowX * sobelMagnitudeMeanPowY - pow(sobelMagnitudeMeanXY, 2) - cache->lamda * pow(sobelMagnitudeMeanPowX + sobelMagnitudeMeanPowY, 2)) > 0.01)
+                            cache->cornerImage[iy * width + ix] = 255;
+                        else
+                            cache->cornerImage[iy * width + ix] = 0;
+                    }
+            }
+    }
+
+    cache->initialized = true;
+
+    memcpy(outputImage, cache->cornerImage, sizeof(byte_t) * imageSize.cx * imageSize.cy);
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,93 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Density Index.h"
+#include "Pyramid.h"
+
+#include <cstddef>
+
+// +-------------------------------------------< HARRIS CORNER >--------------------------------------------+
+
+// Corners within HARRIS_GAUSSIAN_BORDER sigmas of the border, where the Gaussian window reaches the zero
+// gradients of the image border, are not reported by HarrisCornerGaussian.
+static const double HARRIS_GAUSSIAN_BORDER = 2.0;
+
+byte_t* HarrisCorner(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda = 0.05);
+byte_t* HarrisCorner(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda, const bool* tileMask, DensityIndex* densityIndex = NULL);
+
+void           CreateStructureTensorIntegrals(const mag_t* magnitudeX, const mag_t* magnitudeY, lbyte_t* integralImagePowX, lbyte_t* integralImagePowY, lbyte_t* integralImageXY, SIZE imageSize);
+byte_t*        EvaluateHarrisResponse(const lbyte_t* integralImagePowX, const lbyte_t* integralImagePowY, const lbyte_t* integralImageXY, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda, const bool* tileMask, DensityIndex* densityIndex = NULL);
+ScaleSpaceMap* HarrisCornerPyramid(ImagePyramid* pyramid, const int wsize, const double lamda = 0.05);
+byte_t*        HarrisCornerGaussian(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const double sigma, const double lamda = 0.05);
+
+// +-----------------------------------------< BINARY DESCRIPTOR >------------------------------------------+
+
+static const int BRIEF_PAIR_COUNT   = 256;
+static const int BRIEF_PATCH_RADIUS = 15;
+static const int BRIEF_BORDER       = BRIEF_PATCH_RADIUS + 7;
+
+struct BinaryDescriptor
+{
+    uint64_t bits[BRIEF_PAIR_COUNT / 64];
+};
+
+struct DescriptorMatch
+{
+    int trainIndex;
+    int distance;
+    int secondDistance;
+};
+
+struct BriefPattern
+{
+    POINT points[BRIEF_PAIR_COUNT * 2];
+};
+
+BriefPattern      CreateBriefPattern(void);
+size_t            SelectCornerPoints(const byte_t* cornerImage, POINT* points, SIZE imageSize, const size_t maxPointCount, const int minDistance = 8);
+double            CalculatePatchOrientation(const byte_t* inputImage, SIZE imageSize, POINT center);
+size_t            SelectScaleSpaceCorners(const ScaleSpaceMap* cornerMap, ScaleSpacePoint* points, const size_t maxPointCount, const int minDistance = 8);
+BinaryDescriptor* ExtractBinaryDescriptors(const byte_t* inputImage, SIZE imageSize, const POINT* points, const size_t pointCount, BinaryDescriptor* descriptors, const bool oriented = true);
+
+// +------------------------------------------< DESCRIPTOR MATCH >------------------------------------------+
+
+int              CountBits(uint64_t value);
+int              CalculateHammingDistance(const BinaryDescriptor* first, const BinaryDescriptor* second);
+void             MatchBinaryDescriptorRange(const BinaryDescriptor* queryDescriptors, size_t queryBegin, size_t queryEnd, const BinaryDescriptor* trainDescriptors, size_t trainCount, DescriptorMatch* matches);
+DescriptorMatch* MatchBinaryDescriptors(const BinaryDescriptor* queryDescriptors, const size_t queryCount, const BinaryDescriptor* trainDescriptors, const size_t trainCount, DescriptorMatch* matches, int threadCount = 0);
+
+// +-------------------------------------< INCREMENTAL HARRIS CORNER >--------------------------------------+
+
+struct HarrisIncrementalCache
+{
+    bool     initialized;
+    SIZE     imageSize;
+    SIZE     tileCount;
+    int      wsize;
+    double   lamda;
+
+    byte_t*  previousImage;
+    mag_t*   sobelMagnitudeX;
+    mag_t*   sobelMagnitudeY;
+    mag_t*   sobelMagnitudePowX;
+    mag_t*   sobelMagnitudePowY;
+    mag_t*   sobelMagnitudeXY;
+    byte_t*  cornerImage;
+    bool*    dirtyTiles;
+
+    int64_t* integralImagePowX;
+    int64_t* integralImagePowY;
+    int64_t* integralImageXY;
+};
+
+HarrisIncrementalCache* CreateHarrisIncrementalCache(SIZE imageSize, const int wsize, const double lamda = 0.05);
+void                    ReleaseHarrisIncrementalCache(HarrisIncrementalCache* cache);
+int64_t*                CreateRegionIntegralImage(const mag_t* inputImage, int64_t* integralImage, SIZE imageSize, RECT region);
+double                  CalculateRegionWindowAverage(const int64_t* integralImage, RECT region, POINT center, SIZE wsize);
+byte_t*                 HarrisCornerIncremental(HarrisIncrementalCache* cache, const byte_t* inputImage, byte_t* outputImage);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
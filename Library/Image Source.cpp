@@ -0,0 +1,221 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Image Source.h"
+
+#if defined(__SSSE3__)
+    #include <tmmintrin.h>
+#endif
+
+#include <cassert>
+#include <cstring>
+
+// +-----------------------------------------------< IMAGE >------------------------------------------------+
+
+ImageSource CreateGraySource(const byte_t* data, SIZE imageSize, const int stride)
+{
+    assert(data != NULL);
+    assert(stride >= imageSize.cx);
+
+    ImageSource source = { IMAGE_FORMAT_GRAY, imageSize, data, stride };
+
+    return source;
+}
+
+// The Y plane of an NV12 frame comes first, followed by the interleaved half-resolution chroma plane, which
+// the operators do not read.
+ImageSource CreateNV12Source(const byte_t* frame, SIZE imageSize, const int stride)
+{
+    assert(frame != NULL);
+    assert(stride >= imageSize.cx);
+
+    ImageSource source = { IMAGE_FORMAT_NV12, imageSize, frame, stride };
+
+    return source;
+}
+
+// The Y plane of an I420 frame comes first, followed by the U and V planes, which the operators do not read.
+ImageSource CreateI420Source(const byte_t* frame, SIZE imageSize, const int stride)
+{
+    assert(frame != NULL);
+    assert(stride >= imageSize.cx);
+
+    ImageSource source = { IMAGE_FORMAT_I420, imageSize, frame, stride };
+
+    return source;
+}
+
+ImageSource CreateRGBSource(const byte_t* data, SIZE imageSize, const int stride, const bool bgr)
+{
+    assert(data != NULL);
+    assert(stride >= 3 * imageSize.cx);
+
+    ImageSource source = { (bgr) ? (IMAGE_FORMAT_BGR) : (IMAGE_FORMAT_RGB), imageSize, data, stride };
+
+    return source;
+}
+
+bool IsPlanarSource(const ImageSource* source)
+{
+    assert(source != NULL);
+
+    return source->format == IMAGE_FORMAT_GRAY || source->format == IMAGE_FORMAT_NV12 || source->format == IMAGE_FORMAT_I420;
+}
+
+// BT.601 luma in 8-bit fixed point, (77 R + 150 G + 29 B + 128) >> 8. The weights sum to 256, so white stays
+// 255 and the 16-bit sums cannot overflow. With SSSE3 sixteen pixels are deinterleaved per iteration with byte
+// shuffles; the vector and scalar paths give the same result.
+byte_t* ConvertRGBRowToGray(const byte_t* rgbRow, byte_t* grayRow, const int length, const bool bgr)
+{
+    assert(rgbRow  != NULL);
+    assert(grayRow != NULL);
+
+    const int redWeight  = (bgr) ? (29) : (77);
+    const int blueWeight = (bgr) ? (77) : (29);
+
+    int ix = 0;
+
+#if defined(__SSSE3__)
+    const __m128i firstMask[3]  = { _mm_setr_epi8(0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1),
+                                    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14, -1, -1, -1, -1, -1),
+                                    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 1, 4, 7, 10, 13) };
+    const __m128i secondMask[3] = { _mm_setr_epi8(1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1),
+                                    _mm_setr_epi8(-1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15, -1, -1, -1, -1, -1),
+                                    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 2, 5, 8, 11, 14) };
+    const __m128i thirdMask[3]  = { _mm_setr_epi8(2, 5, 8, 11, 14, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1),
+                                    _mm_setr_epi8(-1, -1, -1, -1, -1, 1, 4, 7, 10, 13, -1, -1, -1, -1, -1, -1),
+                                    _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 3, 6, 9, 12, 15) };
+    const __m128i zero          = _mm_setzero_si128();
+    const __m128i rounding      = _mm_set1_epi16(128);
+    const __m128i firstWeight   = _mm_set1_epi16(static_cast<short>(redWeight));
+    const __m128i secondWeight  = _mm_set1_epi16(150);
+    const __m128i thirdWeight   = _mm_set1_epi16(static_cast<short>(blueWeight));
+
+    for (; ix + 16 <= length; ix += 16)
+    {
+        __m128i source[3];
+
+        for (int part = 0; part < 3; ++part)
+            source[part] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rgbRow + 3 * ix + 16 * part));
+
+        __m128i first  = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(source[0], firstMask[0]), _mm_shuffle_epi8(source[1], firstMask[1])), _mm_shuffle_epi8(source[2], firstMask[2]));
+        __m128i second = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(source[0], secondMask[0]), _mm_shuffle_epi8(source[1], secondMask[1])), _mm_shuffle_epi8(source[2], secondMask[2]));
+        __m128i third  = _mm_or_si128(_mm_or_si128(_mm_shuffle_epi8(source[0], thirdMask[0]), _mm_shuffle_epi8(source[1], thirdMask[1])), _mm_shuffle_epi8(source[2], thirdMask[2]));
+        __m128i luma[2];
+
+        for (int half = 0; half < 2; ++half)
+        {
+            __m128i sum = rounding;
+
+            sum = _mm_add_epi16(sum, _mm_mullo_epi16((half == 0) ? (_mm_unpacklo_epi8(first, zero)) : (_mm_unpackhi_epi8(first, zero)), firstWeight));
+            sum = _mm_add_epi16(sum, _mm_mullo_epi16((half == 0) ? (_mm_unpacklo_epi8(second, zero)) : (_mm_unpackhi_epi8(second, zero)), secondWeight));
+            sum = _mm_add_epi16(sum, _mm_mullo_epi16((half == 0) ? (_mm_unpacklo_epi8(third, zero)) : (_mm_unpackhi_epi8(third, zero)), thirdWeight));
+
+            luma[half] = _mm_srli_epi16(sum, 8);
+        }
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(grayRow + ix), _mm_packus_epi16(luma[0], luma[1]));
+    }
+#endif
+
+    for (; ix < length; ++ix)
+        grayRow[ix] = static_cast<byte_t>((redWeight * rgbRow[3 * ix] + 150 * rgbRow[3 * ix + 1] + blueWeight * rgbRow[3 * ix + 2] + 128) >> 8);
+
+    return grayRow;
+}
+
+SourceRowReader* CreateSourceRowReader(const ImageSource* source, const int ringRowCount)
+{
+    assert(source != NULL);
+    assert(ringRowCount > 0);
+
+    SourceRowReader* reader = new SourceRowReader;
+
+    reader->source       = source;
+    reader->ringRowCount = ringRowCount;
+    reader->rows         = NULL;
+    reader->rowIndices   = NULL;
+
+    if (!IsPlanarSource(source))
+    {
+        reader->rows       = new byte_t[static_cast<size_t>(ringRowCount) * source->imageSize.cx];
+        reader->rowIndices = new int[ringRowCount];
+
+        for (int slot = 0; slot < ringRowCount; ++slot)
+            reader->rowIndices[slot] = -1;
+    }
+
+    return reader;
+}
+
+void ReleaseSourceRowReader(SourceRowReader* reader)
+{
+    if (reader == NULL)
+        return;
+
+    delete[] reader->rows;
+    delete[] reader->rowIndices;
+
+    delete reader;
+}
+
+// The gray pixels of row iy, imageSize.cx of them. Planar rows are returned in place; the pointer to a converted
+// row stays valid until ringRowCount other rows have been read.
+const byte_t* ReadSourceRow(SourceRowReader* reader, const int iy)
+{
+    assert(reader != NULL);
+    assert(iy >= 0 && iy < reader->source->imageSize.cy);
+
+    const ImageSource* source = reader->source;
+
+    if (IsPlanarSource(source))
+        return source->data + static_cast<size_t>(iy) * source->stride;
+
+    const int slot = iy % reader->ringRowCount;
+    byte_t*   row  = reader->rows + static_cast<size_t>(slot) * source->imageSize.cx;
+
+    if (reader->rowIndices[slot] != iy)
+    {
+        ConvertRGBRowToGray(source->data + static_cast<size_t>(iy) * source->stride, row, source->imageSize.cx, source->format == IMAGE_FORMAT_BGR);
+
+        reader->rowIndices[slot] = iy;
+    }
+
+    return row;
+}
+
+// A packed width x height gray image of the source for the operators that take one: the luma plane itself when
+// its rows are contiguous, otherwise a conversion into *convertedImage, which ReleaseSourceImage frees.
+const byte_t* AcquireSourceImage(const ImageSource* source, byte_t** convertedImage)
+{
+    assert(source         != NULL);
+    assert(convertedImage != NULL);
+
+    const int width  = source->imageSize.cx;
+    const int height = source->imageSize.cy;
+
+    *convertedImage = NULL;
+
+    if (IsPlanarSource(source) && source->stride == width)
+        return source->data;
+
+    *convertedImage = new byte_t[width * height];
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        const byte_t* row = source->data + static_cast<size_t>(iy) * source->stride;
+
+        if (IsPlanarSource(source))
+            memcpy(*convertedImage + iy * width, row, sizeof(byte_t) * width);
+        else
+            ConvertRGBRowToGray(row, *convertedImage + iy * width, width, source->format == IMAGE_FORMAT_BGR);
+    }
+
+    return *convertedImage;
+}
+
+void ReleaseSourceImage(byte_t* convertedImage)
+{
+    delete[] convertedImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,58 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +-----------------------------------------------< IMAGE >------------------------------------------------+
+
+enum ImageFormat
+{
+    IMAGE_FORMAT_GRAY,
+    IMAGE_FORMAT_NV12,
+    IMAGE_FORMAT_I420,
+    IMAGE_FORMAT_RGB,
+    IMAGE_FORMAT_BGR
+};
+
+// A camera frame as the operators read it: data points at the first pixel of the luma plane for the gray and
+// planar YUV formats, which is used in place, and at the first interleaved pixel for RGB and BGR, which is
+// converted to luma a row at a time. stride is the distance between rows in bytes.
+struct ImageSource
+{
+    ImageFormat   format;
+    SIZE          imageSize;
+    const byte_t* data;
+    int           stride;
+};
+
+// Rows of a source as gray pixels. Converted rows are kept in a ring of ringRowCount rows, so an operator that
+// revisits the last ringRowCount rows, like a convolution band, converts each of them only once.
+struct SourceRowReader
+{
+    const ImageSource* source;
+    int                ringRowCount;
+    byte_t*            rows;
+    int*               rowIndices;
+};
+
+ImageSource      CreateGraySource(const byte_t* data, SIZE imageSize, const int stride);
+ImageSource      CreateNV12Source(const byte_t* frame, SIZE imageSize, const int stride);
+ImageSource      CreateI420Source(const byte_t* frame, SIZE imageSize, const int stride);
+ImageSource      CreateRGBSource(const byte_t* data, SIZE imageSize, const int stride, const bool bgr = false);
+bool             IsPlanarSource(const ImageSource* source);
+
+byte_t*          ConvertRGBRowToGray(const byte_t* rgbRow, byte_t* grayRow, const int length, const bool bgr);
+
+SourceRowReader* CreateSourceRowReader(const ImageSource* source, const int ringRowCount);
+void             ReleaseSourceRowReader(SourceRowReader* reader);
+const byte_t*    ReadSourceRow(SourceRowReader* reader, const int iy);
+
+const byte_t*    AcquireSourceImage(const ImageSource* source, byte_t** convertedImage);
+void             ReleaseSourceImage(byte_t* convertedImage);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
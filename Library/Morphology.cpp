@@ -0,0 +1,245 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Morphology.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <vector>
+
+// +-------------------------------------------< RECONSTRUCTION >-------------------------------------------+
+
+// Grey-level reconstruction by dilation of markerImage under maskImage with 8-connectivity, by Vincent's hybrid
+// algorithm: a forward raster scan and a backward one propagate the marker along both scan orders, and the
+// backward scan queues every pixel that could still raise a neighbor. The FIFO then spreads those values, so
+// the result is exact after two scans plus work proportional to the pixels still changing, instead of one
+// full-frame geodesic dilation per pixel of the longest propagation path. The marker is clipped to the mask
+// first; outputImage may be markerImage.
+byte_t* ReconstructByDilation(const byte_t* markerImage, const byte_t* maskImage, byte_t* outputImage, SIZE imageSize)
+{
+    assert(markerImage != NULL);
+    assert(maskImage   != NULL);
+    assert(outputImage != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    std::vector<int> queue;
+
+    for (int index = 0; index < width * height; ++index)
+        outputImage[index] = std::min(markerImage[index], maskImage[index]);
+
+    for (int iy = 0; iy < height; ++iy)
+        for (int ix = 0; ix < width; ++ix)
+        {
+            byte_t value = outputImage[iy * width + ix];
+
+            if (ix > 0)
+                value = std::max(value, outputImage[iy * width + (ix - 1)]);
+            if (iy > 0)
+                for (int nx = std::max(ix - 1, 0); nx <= std::min(ix + 1, width - 1); ++nx)
+                    value = std::max(value, outputImage[(iy - 1) * width + nx]);
+
+            outputImage[iy * width + ix] = std::min(value, maskImage[iy * width + ix]);
+        }
+
+    for (int iy = height - 1; iy >= 0; --iy)
+        for (int ix = width - 1; ix >= 0; --ix)
+        {
+            byte_t value = outputImage[iy * width + ix];
+
+            if (ix < width - 1)
+                value = std::max(value, outputImage[iy * width + (ix + 1)]);
+            if (iy < height - 1)
+                for (int nx = std::max(ix - 1, 0); nx <= std::min(ix + 1, width - 1); ++nx)
+                    value = std::max(value, outputImage[(iy + 1) * width + nx]);
+
+            value                        = std::min(value, maskImage[iy * width + ix]);
+            outputImage[iy * width + ix] = value;
+
+            // The neighbors already visited by this scan that value could still raise.
+            bool propagates = ix < width - 1 && outputImage[iy * width + (ix + 1)] < value && outputImage[iy * width + (ix + 1)] < maskImage[iy * width + (ix + 1)];
+
+            if (iy < height - 1)
+                for (int nx = std::max(ix - 1, 0); nx <= std::min(ix + 1, width - 1) && !propagates; ++nx)
+                    propagates = outputImage[(iy + 1) * width + nx] < value && outputImage[(iy + 1) * width + nx] < maskImage[(iy + 1) * width + nx];
+
+            if (propagates)
+                queue.push_back(iy * width + ix);
+        }
+
+    for (size_t head = 0; head < queue.size(); ++head)
+    {
+        const int    index = queue[head];
+        const int    x     = index % width;
+        const int    y     = index / width;
+        const byte_t value = outputImage[index];
+
+        for (int ny = std::max(y - 1, 0); ny <= std::min(y + 1, height - 1); ++ny)
+            for (int nx = std::max(x - 1, 0); nx <= std::min(x + 1, width - 1); ++nx)
+            {
+                const int neighbor = ny * width + nx;
+
+                if (outputImage[neighbor] < value && outputImage[neighbor] != maskImage[neighbor])
+                {
+                    outputImage[neighbor] = std::min(value, maskImage[neighbor]);
+                    queue.push_back(neighbor);
+                }
+            }
+    }
+
+    return outputImage;
+}
+
+// Reconstruction by erosion of markerImage above maskImage, as the dual of the reconstruction by dilation of
+// the inverted images.
+byte_t* ReconstructByErosion(const byte_t* markerImage, const byte_t* maskImage, byte_t* outputImage, SIZE imageSize)
+{
+    assert(markerImage != NULL);
+    assert(maskImage   != NULL);
+    assert(outputImage != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    byte_t* invertedMask = new byte_t[width * height];
+
+    for (int index = 0; index < width * height; ++index)
+    {
+        invertedMask[index] = 255 - maskImage[index];
+        outputImage[index]  = 255 - markerImage[index];
+    }
+
+    ReconstructByDilation(outputImage, invertedMask, outputImage, imageSize);
+
+    for (int index = 0; index < width * height; ++index)
+        outputImage[index] = 255 - outputImage[index];
+
+    delete[] invertedMask;
+
+    return outputImage;
+}
+
+// +----------------------------------------------< OPENING >-----------------------------------------------+
+
+// Erosion followed by dilation with the element, both by the running extremum of CalculateElementMin/Max.
+byte_t* Opening(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    byte_t* erosionImage = new byte_t[imageSize.cx * imageSize.cy];
+
+    CalculateElementMin(inputImage, erosionImage, imageSize, element);
+    CalculateElementMax(erosionImage, outputImage, imageSize, element);
+
+    delete[] erosionImage;
+
+    return outputImage;
+}
+
+byte_t* Closing(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    byte_t* dilationImage = new byte_t[imageSize.cx * imageSize.cy];
+
+    CalculateElementMax(inputImage, dilationImage, imageSize, element);
+    CalculateElementMin(dilationImage, outputImage, imageSize, element);
+
+    delete[] dilationImage;
+
+    return outputImage;
+}
+
+// The erosion by the element reconstructed under the input: the structures the element fits in are restored
+// with their exact shape rather than the shape of the element.
+byte_t* OpeningByReconstruction(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    CalculateElementMin(inputImage, outputImage, imageSize, element);
+
+    return ReconstructByDilation(outputImage, inputImage, outputImage, imageSize);
+}
+
+byte_t* ClosingByReconstruction(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    CalculateElementMax(inputImage, outputImage, imageSize, element);
+
+    return ReconstructByErosion(outputImage, inputImage, outputImage, imageSize);
+}
+
+// +----------------------------------------------< TOP-HAT >-----------------------------------------------+
+
+byte_t* WhiteTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const bool byReconstruction)
+{
+    StructuringElement element = CreateRectangleElement(wsize);
+
+    return WhiteTopHat(inputImage, outputImage, imageSize, &element, byReconstruction);
+}
+
+// The input minus its opening: the bright structures the element does not fit in, as unnormalized residues.
+// The opening never exceeds the input, also at the border, where CalculateElementMin/Max cover the part of the
+// element inside the image, so the difference cannot wrap.
+byte_t* WhiteTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element, const bool byReconstruction)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    if (byReconstruction)
+        OpeningByReconstruction(inputImage, outputImage, imageSize, element);
+    else
+        Opening(inputImage, outputImage, imageSize, element);
+
+    for (int index = 0; index < imageSize.cx * imageSize.cy; ++index)
+    {
+        assert(outputImage[index] <= inputImage[index]);
+
+        outputImage[index] = inputImage[index] - outputImage[index];
+    }
+
+    return outputImage;
+}
+
+byte_t* BlackTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const bool byReconstruction)
+{
+    StructuringElement element = CreateRectangleElement(wsize);
+
+    return BlackTopHat(inputImage, outputImage, imageSize, &element, byReconstruction);
+}
+
+// The closing minus the input: the dark structures the element does not fit in, as unnormalized residues; the
+// closing is never below the input.
+byte_t* BlackTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element, const bool byReconstruction)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    if (byReconstruction)
+        ClosingByReconstruction(inputImage, outputImage, imageSize, element);
+    else
+        Closing(inputImage, outputImage, imageSize, element);
+
+    for (int index = 0; index < imageSize.cx * imageSize.cy; ++index)
+    {
+        assert(outputImage[index] >= inputImage[index]);
+
+        outputImage[index] = outputImage[index] - inputImage[index];
+    }
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,29 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Structuring Element.h"
+
+// +-------------------------------------------< RECONSTRUCTION >-------------------------------------------+
+
+byte_t* ReconstructByDilation(const byte_t* markerImage, const byte_t* maskImage, byte_t* outputImage, SIZE imageSize);
+byte_t* ReconstructByErosion(const byte_t* markerImage, const byte_t* maskImage, byte_t* outputImage, SIZE imageSize);
+
+// +----------------------------------------------< OPENING >-----------------------------------------------+
+
+byte_t* Opening(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+byte_t* Closing(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+byte_t* OpeningByReconstruction(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+byte_t* ClosingByReconstruction(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+
+// +----------------------------------------------< TOP-HAT >-----------------------------------------------+
+
+byte_t* WhiteTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const bool byReconstruction = false);
+byte_t* WhiteTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element, const bool byReconstruction = false);
+byte_t* BlackTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const bool byReconstruction = false);
+byte_t* BlackTopHat(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element, const bool byReconstruction = false);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
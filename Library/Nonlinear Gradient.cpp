@@ -0,0 +1,171 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Nonlinear Gradient.h"
+#include "Utility.h"
+
+#include <cassert>
+#include <cstring>
+
+// +------------------------------------------< BLOCKED GRADIENT >------------------------------------------+
+
+// Tile-major evaluation for blocked images: every block is computed from the window ForEachImageBlock gathers
+// around it, so the window extrema never stride across the full image width. The results equal those of the
+// row-major functions.
+static BlockedImage* CalculateBlockedGradientEdge(const BlockedImage* inputImage, BlockedImage* outputImage, SIZE wsize, const bool dilation)
+{
+    assert(inputImage   != NULL);
+    assert(outputImage  != NULL);
+    assert(inputImage->imageSize.cx == outputImage->imageSize.cx);
+    assert(inputImage->imageSize.cy == outputImage->imageSize.cy);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int width  = inputImage->imageSize.cx;
+    const int height = inputImage->imageSize.cy;
+
+    ForEachImageBlock(inputImage, { wsize.cx / 2, wsize.cy / 2 }, [&](int bx, int by, RECT blockRect, const byte_t* window, RECT windowRect) {
+        const SIZE windowSize = { windowRect.right - windowRect.left, windowRect.bottom - windowRect.top };
+        byte_t*    block      = outputImage->blocks + CalculateBlockOffset(outputImage, bx, by);
+
+        memset(block, 0, sizeof(byte_t) * IMAGE_BLOCK_PIXEL_COUNT);
+
+        for (int iy = std::max<int>(blockRect.top, wsize.cy / 2); iy < std::min<int>(blockRect.bottom, height - wsize.cy / 2); ++iy)
+            for (int ix = std::max<int>(blockRect.left, wsize.cx / 2); ix < std::min<int>(blockRect.right, width - wsize.cx / 2); ++ix)
+            {
+                const POINT  center = { ix - windowRect.left, iy - windowRect.top };
+                const byte_t pixel  = window[center.y * windowSize.cx + center.x];
+
+                block[(iy - blockRect.top) * IMAGE_BLOCK_SIZE + (ix - blockRect.left)] = (dilation) ? (CalculateWindowMax(window, windowSize, center, wsize) - pixel) : (pixel - CalculateWindowMin(window, windowSize, center, wsize));
+            }
+    });
+
+    return NormalizeBlockedImage(outputImage->blocks, outputImage);
+}
+
+// +----------------------------------------------< DILATION >----------------------------------------------+
+
+byte_t* DilationEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage   != NULL);
+    assert(outputImage  != NULL);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    if (IsRunningWindowSelected(imageSize, wsize))
+    {
+        StructuringElement element = CreateRectangleElement(wsize);
+
+        return DilationEdge(inputImage, outputImage, imageSize, &element);
+    }
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    memset(outputImage, 0, sizeof(byte_t) * width * height);
+
+    for (int iy = wsize.cy / 2; iy < height - wsize.cy / 2; ++iy)
+        for (int ix = wsize.cx / 2; ix < width - wsize.cx / 2; ++ix)
+            outputImage[iy * width + ix] = CalculateWindowMax(inputImage, imageSize, { ix, iy }, wsize) - inputImage[iy * width + ix];
+
+    Normalization(outputImage, outputImage, imageSize);
+
+    return outputImage;
+}
+
+byte_t* DilationEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+    assert(element->extent.cx < imageSize.cx / 2);
+    assert(element->extent.cy < imageSize.cy / 2);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    byte_t* dilationImage = new byte_t[width * height];
+
+    memset(outputImage, 0, sizeof(byte_t) * width * height);
+
+    CalculateElementMax(inputImage, dilationImage, imageSize, element);
+
+    for (int iy = element->extent.cy; iy < height - element->extent.cy; ++iy)
+        for (int ix = element->extent.cx; ix < width - element->extent.cx; ++ix)
+            outputImage[iy * width + ix] = dilationImage[iy * width + ix] - inputImage[iy * width + ix];
+
+    Normalization(outputImage, outputImage, imageSize);
+
+    delete[] dilationImage;
+
+    return outputImage;
+}
+
+BlockedImage* DilationEdge(const BlockedImage* inputImage, BlockedImage* outputImage, SIZE wsize)
+{
+    return CalculateBlockedGradientEdge(inputImage, outputImage, wsize, true);
+}
+
+// +----------------------------------------------< EROSION >-----------------------------------------------+
+
+byte_t* ErosionEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage   != NULL);
+    assert(outputImage  != NULL);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    if (IsRunningWindowSelected(imageSize, wsize))
+    {
+        StructuringElement element = CreateRectangleElement(wsize);
+
+        return ErosionEdge(inputImage, outputImage, imageSize, &element);
+    }
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    memset(outputImage, 0, sizeof(byte_t) * width * height);
+
+    for (int iy = wsize.cy / 2; iy < height - wsize.cy / 2; ++iy)
+        for (int ix = wsize.cx / 2; ix < width - wsize.cx / 2; ++ix)
+            outputImage[iy * width + ix] = inputImage[iy * width + ix] - CalculateWindowMin(inputImage, imageSize, { ix, iy }, wsize);
+
+    Normalization(outputImage, outputImage, imageSize);
+
+    return outputImage;
+}
+
+byte_t* ErosionEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+    assert(element->extent.cx < imageSize.cx / 2);
+    assert(element->extent.cy < imageSize.cy / 2);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    byte_t* erosionImage = new byte_t[width * height];
+
+    memset(outputImage, 0, sizeof(byte_t) * width * height);
+
+    CalculateElementMin(inputImage, erosionImage, imageSize, element);
+
+    for (int iy = element->extent.cy; iy < height - element->extent.cy; ++iy)
+        for (int ix = element->extent.cx; ix < width - element->extent.cx; ++ix)
+            outputImage[iy * width + ix] = inputImage[iy * width + ix] - erosionImage[iy * width + ix];
+
+    Normalization(outputImage, outputImage, imageSize);
+
+    delete[] erosionImage;
+
+    return outputImage;
+}
+
+BlockedImage* ErosionEdge(const BlockedImage* inputImage, BlockedImage* outputImage, SIZE wsize)
+{
+    return CalculateBlockedGradientEdge(inputImage, outputImage, wsize, false);
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
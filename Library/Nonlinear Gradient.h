@@ -0,0 +1,23 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Blocked Image.h"
+#include "Structuring Element.h"
+
+// +----------------------------------------------< DILATION >----------------------------------------------+
+
+byte_t*       DilationEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+byte_t*       DilationEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+BlockedImage* DilationEdge(const BlockedImage* inputImage, BlockedImage* outputImage, SIZE wsize);
+
+// +----------------------------------------------< EROSION >-----------------------------------------------+
+
+byte_t*       ErosionEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+byte_t*       ErosionEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+BlockedImage* ErosionEdge(const BlockedImage* inputImage, BlockedImage* outputImage, SIZE wsize);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,465 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Nonlinear Laplacian.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+// +-----------------------------------------< LAPLACIAN UTILITY >------------------------------------------+
+
+bool IsZeroCrossing(const int32_t* image, SIZE imageSize, POINT center)
+{
+    assert(image != NULL);
+    assert(center.x >= 1 && center.x < imageSize.cx - 1);
+    assert(center.y >= 1 && center.y < imageSize.cy - 1);
+
+    const int width = imageSize.cx;
+
+    if (image[center.y * width + center.x] == 0 && image[center.y * width + (center.x - 1)] * image[center.y * width + (center.x + 1)] < 0)
+        return true;
+
+    if (image[center.y * width + center.x] * image[center.y * width + (center.x + 1)] < 0)
+        return true;
+
+    if (image[center.y * width + center.x] == 0 && image[(center.y - 1) * width + center.x] * image[(center.y + 1) * width + center.x] < 0)
+        return true;
+
+    if (image[center.y * width + center.x] * image[(center.y + 1) * width + center.x] < 0)
+        return true;
+
+    return false;
+}
+
+byte_t* FindZeroCrossing(const int32_t* inputImage, byte_t* outputImage, SIZE imageSize, DensityIndex* densityIndex)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    memset(outputImage, 255, sizeof(byte_t) * width * height);
+
+    if (densityIndex != NULL)
+        ResetDensityIndex(densityIndex, imageSize);
+
+    for (int iy = 1; iy < height - 1; ++iy)
+    {
+        for (int ix = 1; ix < width - 1; ++ix)
+            if (IsZeroCrossing(inputImage, imageSize, { ix, iy }))
+                outputImage[iy * width + ix] = 0;
+
+        if (densityIndex != NULL)
+            AccumulateDensityRow(densityIndex, outputImage + iy * width, iy, 0);
+    }
+
+    if (densityIndex != NULL)
+        FinishDensityIndex(densityIndex);
+
+    return outputImage;
+}
+
+byte_t* LocalVarianceThreshold(const byte_t* inputImage, const byte_t* inputUnbiasEdgeImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage           != NULL);
+    assert(inputUnbiasEdgeImage != NULL);
+    assert(outputImage          != NULL);
+    assert(wsize.cx % 2         == 1);
+    assert(wsize.cy % 2         == 1);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    double* varianceImage = new double[width * height];
+    double  threshold     = 0.0;
+
+    memset(outputImage, 255, sizeof(byte_t) * width * height);
+
+    CalculateLocalVariance(inputImage, varianceImage, imageSize, wsize);
+
+    // The border of varianceImage is zero, so summing the whole image gives the interior sum.
+    threshold = SumDeterministic(varianceImage, static_cast<size_t>(width) * height) / ((width - wsize.cx + 1) * (height - wsize.cy + 1));
+
+    for (int iy = wsize.cy / 2; iy < height - wsize.cy / 2; ++iy)
+        for (int ix = wsize.cx / 2; ix < width - wsize.cx / 2; ++ix)
+            if (varianceImage[iy * width + ix] >= threshold && inputUnbiasEdgeImage[iy * width + ix] == 0)
+                outputImage[iy * width + ix] = 0;
+
+    delete[] varianceImage;
+
+    return outputImage;
+}
+
+// The sample variance of every window, zero on the border.
+double* CalculateLocalVariance(const byte_t* inputImage, double* varianceImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage    != NULL);
+    assert(varianceImage != NULL);
+    assert(wsize.cx % 2  == 1);
+    assert(wsize.cy % 2  == 1);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    memset(varianceImage, 0, sizeof(double) * width * height);
+
+    for (int iy = wsize.cy / 2; iy < height - wsize.cy / 2; ++iy)
+        for (int ix = wsize.cx / 2; ix < width - wsize.cx / 2; ++ix)
+            varianceImage[iy * width + ix] = CalculateWindowVariance(inputImage, imageSize, { ix, iy }, wsize);
+
+    return varianceImage;
+}
+
+// The sample variance of the window around center, as CalculateLocalVariance stores it.
+double CalculateWindowVariance(const byte_t* inputImage, SIZE imageSize, POINT center, SIZE wsize)
+{
+    assert(inputImage != NULL);
+    assert(center.x >= wsize.cx / 2 && center.x < imageSize.cx - wsize.cx / 2);
+    assert(center.y >= wsize.cy / 2 && center.y < imageSize.cy - wsize.cy / 2);
+
+    const int width = imageSize.cx;
+
+    double mean     = 0.0;
+    double variance = 0.0;
+
+    for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+        for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+            mean += inputImage[(center.y + wy) * width + (center.x + wx)];
+    mean /= wsize.cx * wsize.cy;
+
+    for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+        for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+            variance += (inputImage[(center.y + wy) * width + (center.x + wx)] - mean) * (inputImage[(center.y + wy) * width + (center.x + wx)] - mean);
+
+    return variance / (wsize.cx * wsize.cy - 1);
+}
+
+// Tile-major evaluation for blocked images. The variances are the row-major ones, but their mean is summed in
+// block order, so it may differ from the row-major threshold in the last bits.
+BlockedImage* LocalVarianceThreshold(const BlockedImage* inputImage, const BlockedImage* inputUnbiasEdgeImage, BlockedImage* outputImage, SIZE wsize)
+{
+    assert(inputImage           != NULL);
+    assert(inputUnbiasEdgeImage != NULL);
+    assert(outputImage          != NULL);
+    assert(inputImage->imageSize.cx == outputImage->imageSize.cx && inputImage->imageSize.cx == inputUnbiasEdgeImage->imageSize.cx);
+    assert(inputImage->imageSize.cy == outputImage->imageSize.cy && inputImage->imageSize.cy == inputUnbiasEdgeImage->imageSize.cy);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int    width      = inputImage->imageSize.cx;
+    const int    height     = inputImage->imageSize.cy;
+    const size_t blockCount = static_cast<size_t>(inputImage->blockCount.cx) * inputImage->blockCount.cy;
+
+    double* varianceBlocks = new double[blockCount * IMAGE_BLOCK_PIXEL_COUNT];
+    double  threshold      = 0.0;
+
+    ForEachImageBlock(inputImage, { wsize.cx / 2, wsize.cy / 2 }, [&](int bx, int by, RECT blockRect, const byte_t* window, RECT windowRect) {
+        const int windowWidth   = windowRect.right - windowRect.left;
+        double*   varianceBlock = varianceBlocks + CalculateBlockOffset(inputImage, bx, by);
+
+        memset(varianceBlock, 0, sizeof(double) * IMAGE_BLOCK_PIXEL_COUNT);
+
+        for (int iy = std::max<int>(blockRect.top, wsize.cy / 2); iy < std::min<int>(blockRect.bottom, height - wsize.cy / 2); ++iy)
+            for (int ix = std::max<int>(blockRect.left, wsize.cx / 2); ix < std::min<int>(blockRect.right, width - wsize.cx / 2); ++ix)
+            {
+                const byte_t* center   = window + (iy - windowRect.top) * windowWidth + (ix - windowRect.left);
+                double*       variance = varianceBlock + (iy - blockRect.top) * IMAGE_BLOCK_SIZE + (ix - blockRect.left);
+                double        mean     = 0.0;
+
+                for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+                    for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+                        mean += center[wy * windowWidth + wx];
+                mean /= wsize.cx * wsize.cy;
+
+                for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+                    for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+                        *variance += (center[wy * windowWidth + wx] - mean) * (center[wy * windowWidth + wx] - mean);
+                *variance /= wsize.cx * wsize.cy - 1;
+            }
+    });
+
+    // The border and the block padding are zero, so summing every block gives the interior sum.
+    threshold = SumDeterministic(varianceBlocks, blockCount * IMAGE_BLOCK_PIXEL_COUNT) / ((width - wsize.cx + 1) * (height - wsize.cy + 1));
+
+    for (int by = 0; by < outputImage->blockCount.cy; ++by)
+        for (int bx = 0; bx < outputImage->blockCount.cx; ++bx)
+        {
+            const RECT    blockRect   = CalculateBlockRect(outputImage, bx, by);
+            const size_t  blockOffset = CalculateBlockOffset(outputImage, bx, by);
+            const double* variance    = varianceBlocks + blockOffset;
+            const byte_t* unbiasEdge  = inputUnbiasEdgeImage->blocks + blockOffset;
+            byte_t*       block       = outputImage->blocks + blockOffset;
+
+            memset(block, 255, sizeof(byte_t) * IMAGE_BLOCK_PIXEL_COUNT);
+
+            for (int iy = std::max<int>(blockRect.top, wsize.cy / 2); iy < std::min<int>(blockRect.bottom, height - wsize.cy / 2); ++iy)
+                for (int ix = std::max<int>(blockRect.left, wsize.cx / 2); ix < std::min<int>(blockRect.right, width - wsize.cx / 2); ++ix)
+                {
+                    const int index = (iy - blockRect.top) * IMAGE_BLOCK_SIZE + (ix - blockRect.left);
+
+                    if (variance[index] >= threshold && unbiasEdge[index] == 0)
+                        block[index] = 0;
+                }
+        }
+
+    delete[] varianceBlocks;
+
+    return outputImage;
+}
+
+// +-----------------------------------------------< UNBIAS >-----------------------------------------------+
+
+static inline int8_t CalculateSign(const int value)
+{
+    return static_cast<int8_t>((value > 0) - (value < 0));
+}
+
+// IsZeroCrossing on the signs of three consecutive rows of the unbias image.
+static void FindSignRowZeroCrossing(const int8_t* upperSigns, const int8_t* signs, const int8_t* lowerSigns, byte_t* outputRow, const int width)
+{
+    for (int ix = 1; ix < width - 1; ++ix)
+    {
+        bool crossing;
+
+        if (signs[ix] == 0)
+            crossing = signs[ix - 1] * signs[ix + 1] < 0 || upperSigns[ix] * lowerSigns[ix] < 0;
+        else
+            crossing = signs[ix] * signs[ix + 1] < 0 || signs[ix] * lowerSigns[ix] < 0;
+
+        outputRow[ix] = (crossing) ? (0) : (255);
+    }
+}
+
+// Streams the unbias image through a ring of three sign rows instead of materializing it: calculateSignRow(iy,
+// signs) fills the signs of row iy within unbiasRect, everything outside it being zero, and the zero crossings
+// of a row are found as soon as the row below it is known. Equal to FindZeroCrossing on the full unbias image,
+// since a zero crossing only depends on the signs of its neighbors.
+template <typename SignRowFunction>
+static byte_t* StreamUnbiasZeroCrossing(byte_t* outputImage, SIZE imageSize, RECT unbiasRect, SignRowFunction calculateSignRow)
+{
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    int8_t* signRows = new int8_t[3 * width];
+
+    memset(outputImage, 255, sizeof(byte_t) * width * height);
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        int8_t* signs = signRows + (iy % 3) * width;
+
+        memset(signs, 0, sizeof(int8_t) * width);
+
+        if (iy >= unbiasRect.top && iy < unbiasRect.bottom)
+            calculateSignRow(iy, signs);
+
+        if (iy >= 2)
+            FindSignRowZeroCrossing(signRows + ((iy - 2) % 3) * width, signRows + ((iy - 1) % 3) * width, signs, outputImage + (iy - 1) * width, width);
+    }
+
+    delete[] signRows;
+
+    return outputImage;
+}
+
+// The window extremes are taken jointly and separably: the column extremes over the window height are swept once
+// per row and shared by every window of that row.
+byte_t* UnbiasEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage   != NULL);
+    assert(outputImage  != NULL);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    if (IsRunningWindowSelected(imageSize, wsize))
+    {
+        StructuringElement element = CreateRectangleElement(wsize);
+
+        return UnbiasEdge(inputImage, outputImage, imageSize, &element);
+    }
+
+    const int  width      = imageSize.cx;
+    const RECT unbiasRect = { wsize.cx / 2, wsize.cy / 2, imageSize.cx - wsize.cx / 2, imageSize.cy - wsize.cy / 2 };
+
+    byte_t* columnMax = new byte_t[width];
+    byte_t* columnMin = new byte_t[width];
+
+    StreamUnbiasZeroCrossing(outputImage, imageSize, unbiasRect, [&](int iy, int8_t* signs) {
+        memcpy(columnMax, inputImage + (iy - wsize.cy / 2) * width, sizeof(byte_t) * width);
+        memcpy(columnMin, inputImage + (iy - wsize.cy / 2) * width, sizeof(byte_t) * width);
+
+        for (int wy = -wsize.cy / 2 + 1; wy <= wsize.cy / 2; ++wy)
+        {
+            const byte_t* row = inputImage + (iy + wy) * width;
+
+            for (int ix = 0; ix < width; ++ix)
+            {
+                columnMax[ix] = std::max(columnMax[ix], row[ix]);
+                columnMin[ix] = std::min(columnMin[ix], row[ix]);
+            }
+        }
+
+        for (int ix = unbiasRect.left; ix < unbiasRect.right; ++ix)
+        {
+            byte_t maxValue = columnMax[ix - wsize.cx / 2];
+            byte_t minValue = columnMin[ix - wsize.cx / 2];
+
+            for (int wx = -wsize.cx / 2 + 1; wx <= wsize.cx / 2; ++wx)
+            {
+                maxValue = std::max(maxValue, columnMax[ix + wx]);
+                minValue = std::min(minValue, columnMin[ix + wx]);
+            }
+
+            signs[ix] = CalculateSign(maxValue + minValue - 2 * inputImage[iy * width + ix]);
+        }
+    });
+
+    delete[] columnMax;
+    delete[] columnMin;
+
+    return outputImage;
+}
+
+byte_t* UnbiasEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+    assert(element->extent.cx < imageSize.cx / 2);
+    assert(element->extent.cy < imageSize.cy / 2);
+
+    const int  width      = imageSize.cx;
+    const int  height     = imageSize.cy;
+    const RECT unbiasRect = { element->extent.cx, element->extent.cy, imageSize.cx - element->extent.cx, imageSize.cy - element->extent.cy };
+
+    byte_t* dilationImage = new byte_t[width * height];
+    byte_t* erosionImage  = new byte_t[width * height];
+
+    CalculateElementMax(inputImage, dilationImage, imageSize, element);
+    CalculateElementMin(inputImage, erosionImage, imageSize, element);
+
+    StreamUnbiasZeroCrossing(outputImage, imageSize, unbiasRect, [&](int iy, int8_t* signs) {
+        for (int ix = unbiasRect.left; ix < unbiasRect.right; ++ix)
+            signs[ix] = CalculateSign(dilationImage[iy * width + ix] + erosionImage[iy * width + ix] - 2 * inputImage[iy * width + ix]);
+    });
+
+    delete[] dilationImage;
+    delete[] erosionImage;
+
+    return outputImage;
+}
+
+// +-----------------------------------------< INCREMENTAL UNBIAS >-----------------------------------------+
+
+UnbiasIncrementalCache* CreateUnbiasIncrementalCache(SIZE imageSize, SIZE wsize)
+{
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int  width     = imageSize.cx;
+    const int  height    = imageSize.cy;
+    const SIZE tileCount = CalculateTileCount(imageSize);
+
+    UnbiasIncrementalCache* cache = new UnbiasIncrementalCache;
+
+    cache->initialized   = false;
+    cache->imageSize     = imageSize;
+    cache->tileCount     = tileCount;
+    cache->wsize         = wsize;
+    cache->previousImage = new byte_t[width * height];
+    cache->unbiasImage   = new int32_t[width * height];
+    cache->edgeImage     = new byte_t[width * height];
+    cache->dirtyTiles    = new bool[tileCount.cx * tileCount.cy];
+
+    memset(cache->unbiasImage, 0, sizeof(int32_t) * width * height);
+    memset(cache->edgeImage, 255, sizeof(byte_t) * width * height);
+
+    return cache;
+}
+
+void ReleaseUnbiasIncrementalCache(UnbiasIncrementalCache* cache)
+{
+    assert(cache != NULL);
+
+    delete[] cache->previousImage;
+    delete[] cache->unbiasImage;
+    delete[] cache->edgeImage;
+    delete[] cache->dirtyTiles;
+
+    delete cache;
+}
+
+// Equivalent to UnbiasEdge with the window size the cache was created with. A changed tile invalidates the
+// unbias values within half a window around it and the zero crossings one pixel further out, so only that
+// neighborhood is recomputed; everything else is served from the cached frame.
+byte_t* UnbiasEdgeIncremental(UnbiasIncrementalCache* cache, const byte_t* inputImage, byte_t* outputImage)
+{
+    assert(cache       != NULL);
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const SIZE imageSize    = cache->imageSize;
+    const SIZE tileCount    = cache->tileCount;
+    const SIZE wsize        = cache->wsize;
+    const int  width        = imageSize.cx;
+    const RECT crossingRect = { 1, 1, imageSize.cx - 1, imageSize.cy - 1 };
+    const RECT unbiasRect   = { wsize.cx / 2, wsize.cy / 2, imageSize.cx - wsize.cx / 2, imageSize.cy - wsize.cy / 2 };
+    const SIZE unbiasHalo   = { wsize.cx / 2, wsize.cy / 2 };
+    const SIZE crossingHalo = { wsize.cx / 2 + 1, wsize.cy / 2 + 1 };
+
+    bool*  dirtyTiles     = cache->dirtyTiles;
+    size_t dirtyTileCount = tileCount.cx * tileCount.cy;
+
+    if (cache->initialized)
+        dirtyTileCount = FindDirtyTiles(cache->previousImage, inputImage, imageSize, dirtyTiles);
+    else
+        std::fill(dirtyTiles, dirtyTiles + tileCount.cx * tileCount.cy, true);
+
+    if (dirtyTileCount != 0)
+    {
+        for (int ty = 0; ty < tileCount.cy; ++ty)
+            for (int tx = 0; tx < tileCount.cx; ++tx)
+            {
+                if (!dirtyTiles[ty * tileCount.cx + tx])
+                    continue;
+
+                RECT region = CalculateTileRect(tx, ty, unbiasHalo, unbiasRect);
+
+                for (int iy = region.top; iy < region.bottom; ++iy)
+                    for (int ix = region.left; ix < region.right; ++ix)
+                    {
+                        byte_t minValue;
+                        byte_t maxValue;
+
+                        CalculateWindowMinMax(inputImage, imageSize, { ix, iy }, wsize, &minValue, &maxValue);
+
+                        cache->unbiasImage[iy * width + ix] = maxValue + minValue - 2 * inputImage[iy * width + ix];
+                    }
+
+                CopyTile(inputImage, cache->previousImage, imageSize, tx, ty);
+            }
+
+        for (int ty = 0; ty < tileCount.cy; ++ty)
+            for (int tx = 0; tx < tileCount.cx; ++tx)
+            {
+                if (!dirtyTiles[ty * tileCount.cx + tx])
+                    continue;
+
+                RECT region = CalculateTileRect(tx, ty, crossingHalo, crossingRect);
+
+                for (int iy = region.top; iy < region.bottom; ++iy)
+                    for (int ix = region.left; ix < region.right; ++ix)
+                        cache->edgeImage[iy * width + ix] = IsZeroCrossing(cache->unbiasImage, imageSize, { ix, iy }) ? (0) : (255);
+            }
+    }
+
+    cache->initialized = true;
+
+    memcpy(outputImage, cache->edgeImage, sizeof(byte_t) * imageSize.cx * imageSize.cy);
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
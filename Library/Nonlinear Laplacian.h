@@ -0,0 +1,45 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Blocked Image.h"
+#include "Density Index.h"
+#include "Structuring Element.h"
+
+// +-----------------------------------------< LAPLACIAN UTILITY >------------------------------------------+
+
+bool          IsZeroCrossing(const int32_t* image, SIZE imageSize, POINT center);
+byte_t*       FindZeroCrossing(const int32_t* inputImage, byte_t* outputImage, SIZE imageSize, DensityIndex* densityIndex = NULL);
+byte_t*       LocalVarianceThreshold(const byte_t* inputImage, const byte_t* inputUnbiasEdgeImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+BlockedImage* LocalVarianceThreshold(const BlockedImage* inputImage, const BlockedImage* inputUnbiasEdgeImage, BlockedImage* outputImage, SIZE wsize);
+double*       CalculateLocalVariance(const byte_t* inputImage, double* varianceImage, SIZE imageSize, SIZE wsize);
+double        CalculateWindowVariance(const byte_t* inputImage, SIZE imageSize, POINT center, SIZE wsize);
+
+// +-----------------------------------------------< UNBIAS >-----------------------------------------------+
+
+byte_t* UnbiasEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+byte_t* UnbiasEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+
+// +-----------------------------------------< INCREMENTAL UNBIAS >-----------------------------------------+
+
+struct UnbiasIncrementalCache
+{
+    bool     initialized;
+    SIZE     imageSize;
+    SIZE     tileCount;
+    SIZE     wsize;
+
+    byte_t*  previousImage;
+    int32_t* unbiasImage;
+    byte_t*  edgeImage;
+    bool*    dirtyTiles;
+};
+
+UnbiasIncrementalCache* CreateUnbiasIncrementalCache(SIZE imageSize, SIZE wsize);
+void                    ReleaseUnbiasIncrementalCache(UnbiasIncrementalCache* cache);
+byte_t*                 UnbiasEdgeIncremental(UnbiasIncrementalCache* cache, const byte_t* inputImage, byte_t* outputImage);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,330 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Pipeline.h"
+#include "Difference of Inverse Probability.h"
+#include "Difference of Probability.h"
+#include "Entropy Sketch.h"
+#include "Harris Corner Detector.h"
+#include "Nonlinear Gradient.h"
+#include "Nonlinear Laplacian.h"
+#include "Reduction.h"
+#include "Sliding Histogram.h"
+#include "Sobel.h"
+#include "Utility.h"
+
+#include <algorithm>
+#include <cassert>
+
+// +----------------------------------------------< PIPELINE >----------------------------------------------+
+
+Pipeline CreatePipeline(SIZE imageSize)
+{
+    Pipeline pipeline;
+
+    pipeline.imageSize   = imageSize;
+    pipeline.stageCount  = 1;
+    pipeline.outputCount = 0;
+
+    pipeline.stages[0].operation   = PIPELINE_INPUT;
+    pipeline.stages[0].inputs[0]   = -1;
+    pipeline.stages[0].inputs[1]   = -1;
+    pipeline.stages[0].wsize       = { 0, 0 };
+    pipeline.stages[0].parameter   = 0.0;
+    pipeline.stages[0].outputIndex = -1;
+
+    return pipeline;
+}
+
+static bool IsWindowedOperator(PipelineOperator operation)
+{
+    return operation != PIPELINE_SOBEL_EDGE && operation != PIPELINE_MAX_EDGE_RATIO_THRESHOLD && operation != PIPELINE_MIN_EDGE_RATIO_THRESHOLD;
+}
+
+static bool IsPointwiseOperator(PipelineOperator operation)
+{
+    return operation == PIPELINE_MAX_EDGE_RATIO_THRESHOLD || operation == PIPELINE_MIN_EDGE_RATIO_THRESHOLD;
+}
+
+// Returns the index of the new stage, or -1 when the pipeline is full or the stage is malformed.
+int AddPipelineStage(Pipeline* pipeline, PipelineOperator operation, const int input, const int secondInput, SIZE wsize, const double parameter)
+{
+    assert(pipeline != NULL);
+
+    const int  stageCount = pipeline->stageCount;
+    const bool twoInputs  = operation == PIPELINE_LOCAL_VARIANCE_THRESHOLD;
+
+    if (stageCount == MAX_PIPELINE_STAGE_COUNT || operation == PIPELINE_INPUT || input < 0 || input >= stageCount)
+        return -1;
+
+    if (twoInputs != (secondInput >= 0) || secondInput >= stageCount)
+        return -1;
+
+    if (IsWindowedOperator(operation) && (wsize.cx <= 0 || wsize.cy <= 0 || wsize.cx % 2 == 0 || wsize.cy % 2 == 0))
+        return -1;
+
+    // HarrisCorner takes a square window.
+    if (operation == PIPELINE_HARRIS_CORNER && wsize.cx != wsize.cy)
+        return -1;
+
+    if (IsPointwiseOperator(operation) && (parameter <= 0.0 || parameter > 1.0))
+        return -1;
+
+    PipelineStage& stage = pipeline->stages[stageCount];
+
+    stage.operation   = operation;
+    stage.inputs[0]   = input;
+    stage.inputs[1]   = secondInput;
+    stage.wsize       = wsize;
+    stage.parameter   = parameter;
+    stage.outputIndex = -1;
+
+    return pipeline->stageCount++;
+}
+
+int AddPipelineStage(Pipeline* pipeline, PipelineOperator operation, const int input, SIZE wsize, const double parameter)
+{
+    return AddPipelineStage(pipeline, operation, input, -1, wsize, parameter);
+}
+
+// Returns the slot of the stage in the output images passed to ExecutePipeline.
+int MarkPipelineOutput(Pipeline* pipeline, const int stage)
+{
+    assert(pipeline != NULL);
+
+    if (stage <= 0 || stage >= pipeline->stageCount)
+        return -1;
+
+    if (pipeline->stages[stage].outputIndex < 0)
+        pipeline->stages[stage].outputIndex = pipeline->outputCount++;
+
+    return pipeline->stages[stage].outputIndex;
+}
+
+// +-------------------------------------------< PIPELINE PLAN >--------------------------------------------+
+
+// Stages that no output depends on are left out of the plan, with wave -1.
+PipelinePlan* CreatePipelinePlan(const Pipeline* pipeline)
+{
+    assert(pipeline != NULL);
+
+    const int stageCount = pipeline->stageCount;
+
+    PipelinePlan* plan = new PipelinePlan;
+
+    int  consumerCount[MAX_PIPELINE_STAGE_COUNT] = { 0 };
+    int  lastWave[MAX_PIPELINE_STAGE_COUNT];
+    int  frameFreeWave[MAX_PIPELINE_STAGE_COUNT];
+    bool needed[MAX_PIPELINE_STAGE_COUNT] = { false };
+
+    plan->pipeline   = *pipeline;
+    plan->waveCount  = 1;
+    plan->frameCount = 0;
+    plan->frames     = NULL;
+
+    for (int stage = stageCount - 1; stage > 0; --stage)
+    {
+        const PipelineStage& current = pipeline->stages[stage];
+
+        needed[stage] = needed[stage] || current.outputIndex >= 0;
+
+        if (needed[stage])
+            for (int input = 0; input < 2; ++input)
+                if (current.inputs[input] >= 0)
+                {
+                    needed[current.inputs[input]] = true;
+                    ++consumerCount[current.inputs[input]];
+                }
+    }
+
+    // A stage runs one wave after the latest of its inputs, and a frame must outlive the last wave reading it.
+    for (int stage = 0; stage < stageCount; ++stage)
+    {
+        const PipelineStage& current = pipeline->stages[stage];
+
+        plan->waves[stage]         = (stage == 0) ? (0) : (-1);
+        plan->fused[stage]         = false;
+        plan->buffers[stage]       = PIPELINE_INPUT_BUFFER;
+        plan->outputIndices[stage] = -1;
+        lastWave[stage]            = 0;
+
+        if (stage == 0 || !needed[stage])
+            continue;
+
+        for (int input = 0; input < 2; ++input)
+            if (current.inputs[input] >= 0)
+                plan->waves[stage] = std::max(plan->waves[stage], plan->waves[current.inputs[input]] + 1);
+
+        for (int input = 0; input < 2; ++input)
+            if (current.inputs[input] >= 0)
+                lastWave[current.inputs[input]] = std::max(lastWave[current.inputs[input]], plan->waves[stage]);
+
+        plan->fused[stage] = IsPointwiseOperator(current.operation) && current.inputs[0] > 0 && consumerCount[current.inputs[0]] == 1 &&
+                             pipeline->stages[current.inputs[0]].outputIndex < 0;
+        plan->waveCount    = std::max(plan->waveCount, plan->waves[stage] + 1);
+    }
+
+    // A fused chain shares the frame of its first stage, which lives as long as the last stage of the chain is
+    // read; when that last stage is an output, the whole chain is written straight into the output image.
+    for (int wave = 1; wave < plan->waveCount; ++wave)
+    {
+        int freeFrames[MAX_PIPELINE_STAGE_COUNT];
+        int freeFrameCount = 0;
+
+        for (int frame = 0; frame < plan->frameCount; ++frame)
+            if (frameFreeWave[frame] < wave)
+                freeFrames[freeFrameCount++] = frame;
+
+        for (int stage = 1; stage < stageCount; ++stage)
+        {
+            if (plan->waves[stage] != wave)
+                continue;
+
+            if (plan->fused[stage])
+            {
+                plan->buffers[stage]       = plan->buffers[pipeline->stages[stage].inputs[0]];
+                plan->outputIndices[stage] = plan->outputIndices[pipeline->stages[stage].inputs[0]];
+
+                continue;
+            }
+
+            int tail = stage;
+
+            for (bool extended = true; extended; )
+            {
+                extended = false;
+
+                for (int consumer = tail + 1; consumer < stageCount; ++consumer)
+                    if (plan->fused[consumer] && pipeline->stages[consumer].inputs[0] == tail)
+                    {
+                        tail     = consumer;
+                        extended = true;
+
+                        break;
+                    }
+            }
+
+            if (pipeline->stages[tail].outputIndex >= 0)
+            {
+                plan->buffers[stage]       = PIPELINE_OUTPUT_BUFFER;
+                plan->outputIndices[stage] = pipeline->stages[tail].outputIndex;
+
+                continue;
+            }
+
+            const int frame = (freeFrameCount > 0) ? (freeFrames[--freeFrameCount]) : (plan->frameCount++);
+
+            plan->buffers[stage] = frame;
+            frameFreeWave[frame] = lastWave[tail];
+        }
+    }
+
+    plan->frames = new byte_t*[plan->frameCount];
+
+    for (int frame = 0; frame < plan->frameCount; ++frame)
+        plan->frames[frame] = new byte_t[pipeline->imageSize.cx * pipeline->imageSize.cy];
+
+    return plan;
+}
+
+void ReleasePipelinePlan(PipelinePlan* plan)
+{
+    assert(plan != NULL);
+
+    for (int frame = 0; frame < plan->frameCount; ++frame)
+        delete[] plan->frames[frame];
+
+    delete[] plan->frames;
+
+    delete plan;
+}
+
+static byte_t* ResolvePipelineImage(const PipelinePlan* plan, const int stage, const byte_t* inputImage, byte_t** outputImages)
+{
+    switch (plan->buffers[stage])
+    {
+    case PIPELINE_INPUT_BUFFER:
+        return const_cast<byte_t*>(inputImage);
+    case PIPELINE_OUTPUT_BUFFER:
+        return outputImages[plan->outputIndices[stage]];
+    default:
+        return plan->frames[plan->buffers[stage]];
+    }
+}
+
+static void ExecutePipelineStage(const PipelinePlan* plan, const int stage, const byte_t* inputImage, byte_t** outputImages)
+{
+    const PipelineStage& current   = plan->pipeline.stages[stage];
+    const SIZE           imageSize = plan->pipeline.imageSize;
+    const SIZE           wsize     = current.wsize;
+    const byte_t*        input     = ResolvePipelineImage(plan, current.inputs[0], inputImage, outputImages);
+    byte_t*              output    = ResolvePipelineImage(plan, stage, inputImage, outputImages);
+
+    switch (current.operation)
+    {
+    case PIPELINE_SOBEL_EDGE:
+        SobelEdge(input, output, imageSize);
+        break;
+    case PIPELINE_HARRIS_CORNER:
+        HarrisCorner(input, output, imageSize, wsize.cx, current.parameter);
+        break;
+    case PIPELINE_DILATION_EDGE:
+        DilationEdge(input, output, imageSize, wsize);
+        break;
+    case PIPELINE_EROSION_EDGE:
+        ErosionEdge(input, output, imageSize, wsize);
+        break;
+    case PIPELINE_UNBIAS_EDGE:
+        UnbiasEdge(input, output, imageSize, wsize);
+        break;
+    case PIPELINE_ENTROPY_SKETCH_EDGE:
+        EntropySketchEdge(input, output, imageSize, wsize);
+        break;
+    case PIPELINE_DP_EDGE:
+        DPEdge(input, output, imageSize, wsize);
+        break;
+    case PIPELINE_DIP_EDGE:
+        DIPEdge(input, output, imageSize, wsize);
+        break;
+    case PIPELINE_LOCAL_MEDIAN:
+        LocalMedian(input, output, imageSize, wsize);
+        break;
+    case PIPELINE_LOCAL_VARIANCE_THRESHOLD:
+        LocalVarianceThreshold(input, ResolvePipelineImage(plan, current.inputs[1], inputImage, outputImages), output, imageSize, wsize);
+        break;
+    case PIPELINE_MAX_EDGE_RATIO_THRESHOLD:
+        MaxEdgeRatioThreshold(input, output, imageSize, current.parameter);
+        break;
+    case PIPELINE_MIN_EDGE_RATIO_THRESHOLD:
+        MinEdgeRatioThreshold(input, output, imageSize, current.parameter);
+        break;
+    default:
+        assert(false);
+    }
+}
+
+// outputImages holds one frame per output of the pipeline, in the order the outputs were marked.
+bool ExecutePipeline(const PipelinePlan* plan, const byte_t* inputImage, byte_t** outputImages)
+{
+    assert(plan != NULL);
+
+    if (inputImage == NULL || (plan->pipeline.outputCount > 0 && outputImages == NULL))
+        return false;
+
+    for (int wave = 1; wave < plan->waveCount; ++wave)
+    {
+        int waveStages[MAX_PIPELINE_STAGE_COUNT];
+        int waveStageCount = 0;
+
+        for (int stage = 1; stage < plan->pipeline.stageCount; ++stage)
+            if (plan->waves[stage] == wave)
+                waveStages[waveStageCount++] = stage;
+
+        RunReductionThreads(waveStageCount, [&](int thread) {
+            ExecutePipelineStage(plan, waveStages[thread], inputImage, outputImages);
+        });
+    }
+
+    return true;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,87 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +----------------------------------------------< PIPELINE >----------------------------------------------+
+
+enum PipelineOperator
+{
+    PIPELINE_INPUT,
+    PIPELINE_SOBEL_EDGE,
+    PIPELINE_HARRIS_CORNER,
+    PIPELINE_DILATION_EDGE,
+    PIPELINE_EROSION_EDGE,
+    PIPELINE_UNBIAS_EDGE,
+    PIPELINE_ENTROPY_SKETCH_EDGE,
+    PIPELINE_DP_EDGE,
+    PIPELINE_DIP_EDGE,
+    PIPELINE_LOCAL_MEDIAN,
+    PIPELINE_LOCAL_VARIANCE_THRESHOLD,
+    PIPELINE_MAX_EDGE_RATIO_THRESHOLD,
+    PIPELINE_MIN_EDGE_RATIO_THRESHOLD
+};
+
+static const int MAX_PIPELINE_STAGE_COUNT = 32;
+
+// One operator applied to the images of earlier stages. inputs[0] is the image the operator works on; only
+// PIPELINE_LOCAL_VARIANCE_THRESHOLD uses inputs[1], the unbias edge image it gates. parameter is lamda for
+// Harris corners and the edge ratio for the thresholds; outputIndex is the slot in the caller's output images
+// the stage is written to, or -1 for an intermediate.
+struct PipelineStage
+{
+    PipelineOperator operation;
+    int              inputs[2];
+    SIZE             wsize;
+    double           parameter;
+    int              outputIndex;
+};
+
+// Stage 0 is the input image and every stage only reads stages added before it, so the stages are always in
+// a valid execution order.
+struct Pipeline
+{
+    SIZE          imageSize;
+    int           stageCount;
+    int           outputCount;
+    PipelineStage stages[MAX_PIPELINE_STAGE_COUNT];
+};
+
+Pipeline CreatePipeline(SIZE imageSize);
+int      AddPipelineStage(Pipeline* pipeline, PipelineOperator operation, const int input, SIZE wsize = { 0, 0 }, const double parameter = 0.0);
+int      AddPipelineStage(Pipeline* pipeline, PipelineOperator operation, const int input, const int secondInput, SIZE wsize, const double parameter = 0.0);
+int      MarkPipelineOutput(Pipeline* pipeline, const int stage);
+
+// +-------------------------------------------< PIPELINE PLAN >--------------------------------------------+
+
+// Where each stage writes: PIPELINE_INPUT_BUFFER for the input itself, an output image of the caller when the
+// stage (or the pointwise stage fused into it) is an output, and otherwise one of the plan's own frames.
+static const int PIPELINE_INPUT_BUFFER  = -1;
+static const int PIPELINE_OUTPUT_BUFFER = -2;
+
+// The stages run wave by wave, the stages of a wave being independent of each other and run in parallel.
+// A stage is fused into its producer when it is a pointwise threshold and the only consumer of a producer
+// that is not itself an output; it then runs in place in the producer's frame. Frames are handed to the
+// stages of a wave once every consumer of their previous contents ran in an earlier wave.
+struct PipelinePlan
+{
+    Pipeline pipeline;
+    int      waveCount;
+    int      waves[MAX_PIPELINE_STAGE_COUNT];
+    bool     fused[MAX_PIPELINE_STAGE_COUNT];
+    int      buffers[MAX_PIPELINE_STAGE_COUNT];
+    int      outputIndices[MAX_PIPELINE_STAGE_COUNT];
+    int      frameCount;
+    byte_t** frames;
+};
+
+PipelinePlan* CreatePipelinePlan(const Pipeline* pipeline);
+void          ReleasePipelinePlan(PipelinePlan* plan);
+bool          ExecutePipeline(const PipelinePlan* plan, const byte_t* inputImage, byte_t** outputImages);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
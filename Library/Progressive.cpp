@@ -0,0 +1,162 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Progressive.h"
+#include "Entropy Sketch.h"
+#include "Harris Corner Detector.h"
+#include "Pyramid.h"
+#include "Sobel.h"
+#include "Utility.h"
+
+#include <cassert>
+#include <cstring>
+
+// +---------------------------------------< PROGRESSIVE EVALUATION >---------------------------------------+
+
+enum ProgressiveOperation
+{
+    PROGRESSIVE_SOBEL_EDGE,
+    PROGRESSIVE_ENTROPY_SKETCH_EDGE,
+    PROGRESSIVE_HARRIS_CORNER
+};
+
+struct ProgressiveParameters
+{
+    int    operation;
+    SIZE   wsize;
+    double lamda;
+};
+
+// Marks the tiles of the finer level (twice the size of coarseSize) that lie within one coarse pixel of a
+// flagged pixel of coarseFlags.
+static bool* FlagFinerTiles(const byte_t* coarseFlags, SIZE coarseSize, SIZE fineSize, bool* tileMask)
+{
+    const SIZE tileCount = CalculateTileCount(fineSize);
+
+    memset(tileMask, 0, sizeof(bool) * tileCount.cx * tileCount.cy);
+
+    for (int iy = 0; iy < coarseSize.cy; ++iy)
+        for (int ix = 0; ix < coarseSize.cx; ++ix)
+        {
+            if (!coarseFlags[iy * coarseSize.cx + ix])
+                continue;
+
+            const int left   = std::max((ix - 1) * 2, 0);
+            const int top    = std::max((iy - 1) * 2, 0);
+            const int right  = std::min((ix + 2) * 2, static_cast<int>(fineSize.cx));
+            const int bottom = std::min((iy + 2) * 2, static_cast<int>(fineSize.cy));
+
+            for (int ty = top / TILE_SIZE; ty <= (bottom - 1) / TILE_SIZE; ++ty)
+                for (int tx = left / TILE_SIZE; tx <= (right - 1) / TILE_SIZE; ++tx)
+                    tileMask[ty * tileCount.cx + tx] = true;
+        }
+
+    return tileMask;
+}
+
+// The edge operators flag the pixels their usual edge ratio threshold keeps (zero in the binary map); Harris
+// flags its corners.
+static byte_t* FlagResponses(const byte_t* resultImage, byte_t* flagImage, SIZE imageSize, const int operation)
+{
+    const int pixelCount = imageSize.cx * imageSize.cy;
+
+    if (operation == PROGRESSIVE_SOBEL_EDGE)
+        MaxEdgeRatioThreshold(resultImage, flagImage, imageSize);
+    else if (operation == PROGRESSIVE_ENTROPY_SKETCH_EDGE)
+        MinEdgeRatioThreshold(resultImage, flagImage, imageSize);
+    else
+        memcpy(flagImage, resultImage, sizeof(byte_t) * pixelCount);
+
+    for (int index = 0; index < pixelCount; ++index)
+        flagImage[index] = (operation == PROGRESSIVE_HARRIS_CORNER) ? (flagImage[index] == 255) : (flagImage[index] == 0);
+
+    return flagImage;
+}
+
+static byte_t* EvaluateLevel(ImagePyramid* pyramid, const int level, byte_t* resultImage, const ProgressiveParameters* parameters, const bool* tileMask)
+{
+    if (parameters->operation == PROGRESSIVE_SOBEL_EDGE)
+    {
+        const PyramidLevel* current = RequirePyramidLevel(pyramid, level, PYRAMID_IMAGE);
+
+        return SobelEdge(current->image, resultImage, current->imageSize, tileMask);
+    }
+
+    if (parameters->operation == PROGRESSIVE_ENTROPY_SKETCH_EDGE)
+    {
+        const PyramidLevel* current = RequirePyramidLevel(pyramid, level, PYRAMID_INTEGRAL_IMAGE);
+
+        return EntropySketchEdge(current->image, resultImage, current->imageSize, parameters->wsize, current->integralImage, tileMask);
+    }
+
+    const PyramidLevel* current = RequirePyramidLevel(pyramid, level, PYRAMID_STRUCTURE_TENSOR);
+
+    return EvaluateHarrisResponse(current->integralImagePowX, current->integralImagePowY, current->integralImageXY, resultImage, current->imageSize, parameters->wsize.cx, parameters->lamda, tileMask);
+}
+
+// The window of the windowed operators is kept at every level, so the coarsest level must still be a few
+// windows wide.
+static byte_t* RunProgressive(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const ProgressiveParameters* parameters, ProgressiveCallback callback, void* userData, const ProgressiveOptions* options)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(options     != NULL);
+
+    const int minLevelSize = std::max(MIN_PYRAMID_LEVEL_SIZE, static_cast<int>(std::max(parameters->wsize.cx, parameters->wsize.cy)) * 4);
+    const int levelCount   = CalculatePyramidLevelCount(imageSize, std::max(options->levelCount, 1), minLevelSize);
+
+    ImagePyramid* pyramid     = CreateImagePyramid(inputImage, imageSize, levelCount);
+    byte_t*       resultImage = new byte_t[imageSize.cx * imageSize.cy];
+    byte_t*       flagImage   = new byte_t[imageSize.cx * imageSize.cy];
+    bool*         tileMask    = new bool[CalculateTileCount(imageSize).cx * CalculateTileCount(imageSize).cy];
+    bool          masked      = false;
+
+    for (int level = levelCount - 1; level >= 0; --level)
+    {
+        const PyramidLevel* current     = &pyramid->levels[level];
+        byte_t*             levelResult = (level == 0) ? outputImage : resultImage;
+
+        EvaluateLevel(pyramid, level, levelResult, parameters, masked ? tileMask : NULL);
+
+        if (callback != NULL)
+            callback(levelResult, current->imageSize, level, userData);
+
+        if (level > 0 && options->refineFlaggedTiles)
+        {
+            FlagResponses(levelResult, flagImage, current->imageSize, parameters->operation);
+            FlagFinerTiles(flagImage, current->imageSize, pyramid->levels[level - 1].imageSize, tileMask);
+
+            masked = true;
+        }
+    }
+
+    delete[] resultImage;
+    delete[] flagImage;
+    delete[] tileMask;
+
+    ReleaseImagePyramid(pyramid);
+
+    return outputImage;
+}
+
+byte_t* SobelEdgeProgressive(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, ProgressiveCallback callback, void* userData, const ProgressiveOptions* options)
+{
+    ProgressiveParameters parameters = { PROGRESSIVE_SOBEL_EDGE, { 3, 3 }, 0.0 };
+
+    return RunProgressive(inputImage, outputImage, imageSize, &parameters, callback, userData, options);
+}
+
+byte_t* EntropySketchEdgeProgressive(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, ProgressiveCallback callback, void* userData, const ProgressiveOptions* options)
+{
+    ProgressiveParameters parameters = { PROGRESSIVE_ENTROPY_SKETCH_EDGE, wsize, 0.0 };
+
+    return RunProgressive(inputImage, outputImage, imageSize, &parameters, callback, userData, options);
+}
+
+byte_t* HarrisCornerProgressive(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda, ProgressiveCallback callback, void* userData, const ProgressiveOptions* options)
+{
+    ProgressiveParameters parameters = { PROGRESSIVE_HARRIS_CORNER, { wsize, wsize }, lamda };
+
+    return RunProgressive(inputImage, outputImage, imageSize, &parameters, callback, userData, options);
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,31 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +---------------------------------------< PROGRESSIVE EVALUATION >---------------------------------------+
+
+// Called once per pyramid level, coarsest first; resultImage is only valid during the call. The level 0 call
+// receives the final result, which is also left in the outputImage of the progressive function.
+typedef void (*ProgressiveCallback)(const byte_t* resultImage, SIZE resultSize, int level, void* userData);
+
+// With refineFlaggedTiles the finer levels are only evaluated in the tiles the coarser level flagged (edges or
+// corners nearby) and report no response elsewhere; without it every level is a full evaluation.
+struct ProgressiveOptions
+{
+    int  levelCount;
+    bool refineFlaggedTiles;
+};
+
+static const ProgressiveOptions DEFAULT_PROGRESSIVE_OPTIONS = { 3, false };
+
+byte_t* SobelEdgeProgressive(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, ProgressiveCallback callback, void* userData, const ProgressiveOptions* options = &DEFAULT_PROGRESSIVE_OPTIONS);
+byte_t* EntropySketchEdgeProgressive(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, ProgressiveCallback callback, void* userData, const ProgressiveOptions* options = &DEFAULT_PROGRESSIVE_OPTIONS);
+byte_t* HarrisCornerProgressive(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int wsize, const double lamda, ProgressiveCallback callback, void* userData, const ProgressiveOptions* options = &DEFAULT_PROGRESSIVE_OPTIONS);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,287 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Pyramid.h"
+#include "Harris Corner Detector.h"
+#include "Sobel.h"
+#include "Utility.h"
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#include <cassert>
+#include <cstring>
+
+// +-------------------------------------------< IMAGE PYRAMID >--------------------------------------------+
+
+SIZE CalculateDecimatedSize(SIZE imageSize)
+{
+    SIZE decimatedSize = { (imageSize.cx + 1) / 2, (imageSize.cy + 1) / 2 };
+
+    return decimatedSize;
+}
+
+// Number of levels, at most maxLevelCount, such that no level is narrower or shorter than minLevelSize.
+int CalculatePyramidLevelCount(SIZE imageSize, const int maxLevelCount, const int minLevelSize)
+{
+    assert(maxLevelCount >= 1);
+
+    int levelCount = 1;
+
+    while (levelCount < maxLevelCount && levelCount < MAX_PYRAMID_LEVEL_COUNT)
+    {
+        imageSize = CalculateDecimatedSize(imageSize);
+
+        if (imageSize.cx < minLevelSize || imageSize.cy < minLevelSize)
+            break;
+
+        ++levelCount;
+    }
+
+    return levelCount;
+}
+
+// [1 4 6 4 1] binomial column pass over five full rows; the sums (at most 16 * 255) fit 16 bits.
+static void FilterDecimationColumn(const byte_t* const rows[5], uint16_t* columnRow, const int width)
+{
+    int ix = 0;
+
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+
+    for (; ix + 16 <= width; ix += 16)
+    {
+        __m128i source[5];
+
+        for (int row = 0; row < 5; ++row)
+            source[row] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[row] + ix));
+
+        for (int half = 0; half < 2; ++half)
+        {
+            __m128i value[5];
+
+            for (int row = 0; row < 5; ++row)
+                value[row] = (half == 0) ? _mm_unpacklo_epi8(source[row], zero) : _mm_unpackhi_epi8(source[row], zero);
+
+            __m128i sum = _mm_add_epi16(value[0], value[4]);
+
+            sum = _mm_add_epi16(sum, _mm_slli_epi16(_mm_add_epi16(value[1], value[3]), 2));
+            sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(value[2], 2), _mm_slli_epi16(value[2], 1)));
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(columnRow + ix + half * 8), sum);
+        }
+    }
+#endif
+
+    for (; ix < width; ++ix)
+        columnRow[ix] = static_cast<uint16_t>(rows[0][ix] + 4 * rows[1][ix] + 6 * rows[2][ix] + 4 * rows[3][ix] + rows[4][ix]);
+}
+
+// Row pass at the even pixels from the deinterleaved column sums: evenValues[k] and oddValues[k] hold the
+// padded column sums 2k and 2k + 1, so output pixel ix is E[ix] + 4 O[ix] + 6 E[ix + 1] + 4 O[ix + 1] +
+// E[ix + 2]. At most 16 * 16 * 255 + 128, which still fits 16 bits.
+static void FilterDecimationRow(const uint16_t* evenValues, const uint16_t* oddValues, byte_t* outputRow, const int width)
+{
+    int ix = 0;
+
+#if defined(__SSE2__)
+    const __m128i rounding = _mm_set1_epi16(128);
+
+    for (; ix + 8 <= width; ix += 8)
+    {
+        __m128i even0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(evenValues + ix));
+        __m128i even1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(evenValues + ix + 1));
+        __m128i even2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(evenValues + ix + 2));
+        __m128i odd0  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(oddValues + ix));
+        __m128i odd1  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(oddValues + ix + 1));
+
+        __m128i sum = _mm_add_epi16(_mm_add_epi16(even0, even2), rounding);
+
+        sum = _mm_add_epi16(sum, _mm_slli_epi16(_mm_add_epi16(odd0, odd1), 2));
+        sum = _mm_add_epi16(sum, _mm_add_epi16(_mm_slli_epi16(even1, 2), _mm_slli_epi16(even1, 1)));
+        sum = _mm_srli_epi16(sum, 8);
+
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(outputRow + ix), _mm_packus_epi16(sum, sum));
+    }
+#endif
+
+    for (; ix < width; ++ix)
+        outputRow[ix] = static_cast<byte_t>((evenValues[ix] + 4 * oddValues[ix] + 6 * evenValues[ix + 1] + 4 * oddValues[ix + 1] + evenValues[ix + 2] + 128) >> 8);
+}
+
+// Separable [1 4 6 4 1] / 16 binomial low-pass evaluated at the even pixels only, with replicated borders. The
+// column pass runs first over the five source rows of each output row, so only one row of intermediate sums
+// is kept and the result is rounded once.
+byte_t* DecimateImage(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const int  width         = imageSize.cx;
+    const int  height        = imageSize.cy;
+    const SIZE decimatedSize = CalculateDecimatedSize(imageSize);
+
+    uint16_t* columnRow  = new uint16_t[width + 4];
+    uint16_t* evenValues = new uint16_t[decimatedSize.cx + 2];
+    uint16_t* oddValues  = new uint16_t[decimatedSize.cx + 1];
+
+    for (int iy = 0; iy < decimatedSize.cy; ++iy)
+    {
+        const int           y       = iy * 2;
+        const byte_t* const rows[5] =
+        {
+            inputImage + std::max(y - 2, 0) * width,
+            inputImage + std::max(y - 1, 0) * width,
+            inputImage + y * width,
+            inputImage + std::min(y + 1, height - 1) * width,
+            inputImage + std::min(y + 2, height - 1) * width
+        };
+
+        FilterDecimationColumn(rows, columnRow + 2, width);
+
+        columnRow[0]         = columnRow[2];
+        columnRow[1]         = columnRow[2];
+        columnRow[width + 2] = columnRow[width + 1];
+        columnRow[width + 3] = columnRow[width + 1];
+
+        for (int index = 0; index < decimatedSize.cx + 2; ++index)
+            evenValues[index] = columnRow[index * 2];
+
+        for (int index = 0; index < decimatedSize.cx + 1; ++index)
+            oddValues[index] = columnRow[index * 2 + 1];
+
+        FilterDecimationRow(evenValues, oddValues, outputImage + iy * decimatedSize.cx, decimatedSize.cx);
+    }
+
+    delete[] columnRow;
+    delete[] evenValues;
+    delete[] oddValues;
+
+    return outputImage;
+}
+
+// Only level 0 exists after creation; the other levels and all derived products are built by
+// RequirePyramidLevel. Each level has a quarter of the pixels of the one below it, so building every product
+// of every level costs at most 4/3 of building it for level 0 alone.
+ImagePyramid* CreateImagePyramid(const byte_t* inputImage, SIZE imageSize, const int levelCount)
+{
+    assert(inputImage != NULL);
+    assert(levelCount >= 1 && levelCount <= MAX_PYRAMID_LEVEL_COUNT);
+
+    ImagePyramid* pyramid = new ImagePyramid;
+
+    memset(pyramid, 0, sizeof(ImagePyramid));
+
+    pyramid->levelCount = levelCount;
+
+    for (int level = 0; level < levelCount; ++level)
+        pyramid->levels[level].imageSize = (level == 0) ? imageSize : CalculateDecimatedSize(pyramid->levels[level - 1].imageSize);
+
+    pyramid->levels[0].image    = inputImage;
+    pyramid->levels[0].products = PYRAMID_IMAGE;
+
+    return pyramid;
+}
+
+void ReleaseImagePyramid(ImagePyramid* pyramid)
+{
+    if (pyramid == NULL)
+        return;
+
+    for (int level = 0; level < pyramid->levelCount; ++level)
+    {
+        PyramidLevel* current = &pyramid->levels[level];
+
+        if (level != 0)
+            delete[] current->image;
+
+        delete[] current->integralImage;
+        delete[] current->magnitudeX;
+        delete[] current->magnitudeY;
+        delete[] current->integralImagePowX;
+        delete[] current->integralImagePowY;
+        delete[] current->integralImageXY;
+    }
+
+    delete pyramid;
+}
+
+// Builds the requested products of the level, and whatever they are derived from, unless already cached.
+PyramidLevel* RequirePyramidLevel(ImagePyramid* pyramid, const int level, const int products)
+{
+    assert(pyramid != NULL);
+    assert(level >= 0 && level < pyramid->levelCount);
+
+    PyramidLevel* current    = &pyramid->levels[level];
+    const SIZE    imageSize  = current->imageSize;
+    const int     pixelCount = imageSize.cx * imageSize.cy;
+
+    if ((current->products & PYRAMID_IMAGE) == 0)
+    {
+        const PyramidLevel* previous = RequirePyramidLevel(pyramid, level - 1, PYRAMID_IMAGE);
+
+        current->image     = DecimateImage(previous->image, new byte_t[pixelCount], previous->imageSize);
+        current->products |= PYRAMID_IMAGE;
+    }
+
+    if ((products & PYRAMID_INTEGRAL_IMAGE) && (current->products & PYRAMID_INTEGRAL_IMAGE) == 0)
+    {
+        current->integralImage = CreateIntegralImage(current->image, new lbyte_t[pixelCount], imageSize);
+        current->products     |= PYRAMID_INTEGRAL_IMAGE;
+    }
+
+    if ((products & (PYRAMID_GRADIENT | PYRAMID_STRUCTURE_TENSOR)) && (current->products & PYRAMID_GRADIENT) == 0)
+    {
+        current->magnitudeX = Sobel(current->image, new mag_t[pixelCount], imageSize, SOBEL_X);
+        current->magnitudeY = Sobel(current->image, new mag_t[pixelCount], imageSize, SOBEL_Y);
+        current->products  |= PYRAMID_GRADIENT;
+    }
+
+    if ((products & PYRAMID_STRUCTURE_TENSOR) && (current->products & PYRAMID_STRUCTURE_TENSOR) == 0)
+    {
+        current->integralImagePowX = new lbyte_t[pixelCount];
+        current->integralImagePowY = new lbyte_t[pixelCount];
+        current->integralImageXY   = new lbyte_t[pixelCount];
+
+        CreateStructureTensorIntegrals(current->magnitudeX, current->magnitudeY, current->integralImagePowX, current->integralImagePowY, current->integralImageXY, imageSize);
+
+        current->products |= PYRAMID_STRUCTURE_TENSOR;
+    }
+
+    return current;
+}
+
+// +--------------------------------------------< SCALE SPACE >---------------------------------------------+
+
+ScaleSpaceMap* CreateScaleSpaceMap(const ImagePyramid* pyramid)
+{
+    assert(pyramid != NULL);
+
+    ScaleSpaceMap* map = new ScaleSpaceMap;
+
+    memset(map, 0, sizeof(ScaleSpaceMap));
+
+    map->levelCount = pyramid->levelCount;
+
+    for (int level = 0; level < pyramid->levelCount; ++level)
+    {
+        map->imageSizes[level] = pyramid->levels[level].imageSize;
+        map->scales[level]     = 1 << level;
+        map->images[level]     = new byte_t[map->imageSizes[level].cx * map->imageSizes[level].cy];
+    }
+
+    return map;
+}
+
+void ReleaseScaleSpaceMap(ScaleSpaceMap* map)
+{
+    if (map == NULL)
+        return;
+
+    for (int level = 0; level < map->levelCount; ++level)
+        delete[] map->images[level];
+
+    delete map;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,78 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +-------------------------------------------< IMAGE PYRAMID >--------------------------------------------+
+
+static const int MAX_PYRAMID_LEVEL_COUNT = 16;
+static const int MIN_PYRAMID_LEVEL_SIZE  = 16;
+
+// Per-level products, built on first request by RequirePyramidLevel and kept until the pyramid is released.
+enum PyramidProduct
+{
+    PYRAMID_IMAGE            = 0x01,
+    PYRAMID_INTEGRAL_IMAGE   = 0x02,
+    PYRAMID_GRADIENT         = 0x04,
+    PYRAMID_STRUCTURE_TENSOR = 0x08
+};
+
+// Level 0 references the caller's image; every other level is the 2x decimation of the level below it. The
+// gradients are the Sobel magnitudes of the level and the structure tensor the integral images of their
+// products, as HarrisCorner uses them. Everything but the level 0 image is owned by the pyramid.
+struct PyramidLevel
+{
+    int           products;
+    SIZE          imageSize;
+    const byte_t* image;
+    lbyte_t*      integralImage;
+
+    mag_t*        magnitudeX;
+    mag_t*        magnitudeY;
+
+    lbyte_t*      integralImagePowX;
+    lbyte_t*      integralImagePowY;
+    lbyte_t*      integralImageXY;
+};
+
+struct ImagePyramid
+{
+    int          levelCount;
+    PyramidLevel levels[MAX_PYRAMID_LEVEL_COUNT];
+};
+
+SIZE          CalculateDecimatedSize(SIZE imageSize);
+int           CalculatePyramidLevelCount(SIZE imageSize, const int maxLevelCount, const int minLevelSize = MIN_PYRAMID_LEVEL_SIZE);
+byte_t*       DecimateImage(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize);
+
+ImagePyramid* CreateImagePyramid(const byte_t* inputImage, SIZE imageSize, const int levelCount);
+void          ReleaseImagePyramid(ImagePyramid* pyramid);
+PyramidLevel* RequirePyramidLevel(ImagePyramid* pyramid, const int level, const int products);
+
+// +--------------------------------------------< SCALE SPACE >---------------------------------------------+
+
+// One result image per pyramid level; a pixel (x, y) of level l lies at (x, y) * scales[l] in level 0.
+struct ScaleSpaceMap
+{
+    int     levelCount;
+    SIZE    imageSizes[MAX_PYRAMID_LEVEL_COUNT];
+    int     scales[MAX_PYRAMID_LEVEL_COUNT];
+    byte_t* images[MAX_PYRAMID_LEVEL_COUNT];
+};
+
+struct ScaleSpacePoint
+{
+    POINT point;
+    POINT levelPoint;
+    int   level;
+};
+
+ScaleSpaceMap* CreateScaleSpaceMap(const ImagePyramid* pyramid);
+void           ReleaseScaleSpaceMap(ScaleSpaceMap* map);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
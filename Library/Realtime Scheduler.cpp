@@ -0,0 +1,247 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Realtime Scheduler.h"
+#include "Entropy Sketch.h"
+#include "Nonlinear Laplacian.h"
+#include "Pyramid.h"
+#include "Utility.h"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+
+// +-----------------------------------------< REALTIME SCHEDULER >-----------------------------------------+
+
+static const double COST_SMOOTHING  = 0.25;
+static const double COST_AGING      = 0.05;
+static const double BUDGET_FRACTION = 0.9;
+
+// A previous threshold would only save the entropy histogram, which costs next to nothing beside the entropy
+// windows, so the entropy tiers do not use it.
+static const int ENTROPY_SKETCH_TIERS[] =
+{
+    DEGRADATION_NONE,
+    DEGRADATION_SMALL_WINDOW,
+    DEGRADATION_SMALL_WINDOW | DEGRADATION_DECIMATED_INPUT
+};
+
+static const int UNBIAS_THRESHOLD_TIERS[] =
+{
+    DEGRADATION_NONE,
+    DEGRADATION_PREVIOUS_THRESHOLD,
+    DEGRADATION_SMALL_WINDOW | DEGRADATION_PREVIOUS_THRESHOLD,
+    DEGRADATION_SMALL_WINDOW | DEGRADATION_SKIP_VARIANCE_GATE,
+    DEGRADATION_SMALL_WINDOW | DEGRADATION_SKIP_VARIANCE_GATE | DEGRADATION_DECIMATED_INPUT
+};
+
+RealtimeScheduler* CreateRealtimeScheduler(const int operation, SIZE imageSize, SIZE wsize, const double edgeRatio)
+{
+    assert(operation == REALTIME_ENTROPY_SKETCH_EDGE || operation == REALTIME_UNBIAS_THRESHOLD_EDGE);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int* tiers     = (operation == REALTIME_ENTROPY_SKETCH_EDGE) ? (ENTROPY_SKETCH_TIERS) : (UNBIAS_THRESHOLD_TIERS);
+    const int  tierCount = (operation == REALTIME_ENTROPY_SKETCH_EDGE) ? (sizeof(ENTROPY_SKETCH_TIERS) / sizeof(int)) : (sizeof(UNBIAS_THRESHOLD_TIERS) / sizeof(int));
+
+    RealtimeScheduler* scheduler = new RealtimeScheduler;
+
+    memset(scheduler, 0, sizeof(RealtimeScheduler));
+
+    scheduler->operation   = operation;
+    scheduler->imageSize   = imageSize;
+    scheduler->wsize       = wsize;
+    scheduler->edgeRatio   = edgeRatio;
+    scheduler->tierCount   = tierCount;
+    scheduler->costPerWork = -1.0;
+
+    for (int tier = 0; tier < tierCount; ++tier)
+    {
+        scheduler->tierDegradations[tier] = tiers[tier];
+        scheduler->tierCost[tier]         = -1.0;
+    }
+
+    return scheduler;
+}
+
+void ReleaseRealtimeScheduler(RealtimeScheduler* scheduler)
+{
+    delete scheduler;
+}
+
+// Relative amount of work of a frame computed with the given reductions: the window passes cost in proportion
+// to pixels times window area, and the unbias pipeline makes three of them (extrema and variance). With a
+// previous threshold the two variance passes only visit the edge pixels, taken to be half of them.
+static double EstimateFrameWork(const RealtimeScheduler* scheduler, const int degradations)
+{
+    const SIZE wsize      = (degradations & DEGRADATION_SMALL_WINDOW) ? (SIZE { 3, 3 }) : (scheduler->wsize);
+    double     passCount  = 2.0;
+    double     pixelCount = static_cast<double>(scheduler->imageSize.cx) * scheduler->imageSize.cy;
+
+    if (scheduler->operation == REALTIME_UNBIAS_THRESHOLD_EDGE)
+    {
+        if (degradations & DEGRADATION_SKIP_VARIANCE_GATE)
+            passCount = 1.0;
+        else
+            passCount = (degradations & DEGRADATION_PREVIOUS_THRESHOLD) ? (2.0) : (3.0);
+    }
+
+    if (degradations & DEGRADATION_DECIMATED_INPUT)
+        pixelCount /= 4.0;
+
+    return pixelCount * wsize.cx * wsize.cy * passCount;
+}
+
+// Measured tiers are predicted by their own moving average, the others from the work calibration; with no
+// measurement at all every tier is predicted to fit.
+static double PredictTierCost(const RealtimeScheduler* scheduler, const int tier)
+{
+    if (scheduler->tierCost[tier] >= 0.0)
+        return scheduler->tierCost[tier];
+
+    if (scheduler->costPerWork >= 0.0)
+        return scheduler->costPerWork * EstimateFrameWork(scheduler, scheduler->tierDegradations[tier]);
+
+    return 0.0;
+}
+
+// The best tier predicted to finish within the given fraction of the budget, or the lowest tier if none is.
+int SelectQualityTier(const RealtimeScheduler* scheduler, const double budgetMicroseconds, double* predictedMicroseconds)
+{
+    assert(scheduler != NULL);
+
+    int tier = 0;
+
+    while (tier < scheduler->tierCount - 1 && PredictTierCost(scheduler, tier) > budgetMicroseconds * BUDGET_FRACTION)
+        ++tier;
+
+    if (predictedMicroseconds != NULL)
+        *predictedMicroseconds = PredictTierCost(scheduler, tier);
+
+    return tier;
+}
+
+// Computes the frame at the reduced size and window of degradations into outputImage, which is of that size.
+// Returns the reductions applied, without DEGRADATION_PREVIOUS_THRESHOLD when no matching threshold exists.
+static int ComputeRealtimeFrame(RealtimeScheduler* scheduler, const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, int degradations)
+{
+    const int  width        = imageSize.cx;
+    const int  height       = imageSize.cy;
+    const SIZE wsize        = (degradations & DEGRADATION_SMALL_WINDOW) ? (SIZE { 3, 3 }) : (scheduler->wsize);
+    const int  thresholdKey = degradations & ~DEGRADATION_PREVIOUS_THRESHOLD;
+
+    if ((degradations & DEGRADATION_PREVIOUS_THRESHOLD) && !(scheduler->thresholdValid && scheduler->thresholdDegradations == thresholdKey))
+        degradations &= ~DEGRADATION_PREVIOUS_THRESHOLD;
+
+    if (scheduler->operation == REALTIME_ENTROPY_SKETCH_EDGE)
+    {
+        uint32_t histogram[256];
+
+        EntropySketchEdge(inputImage, outputImage, imageSize, wsize);
+        CalculateHistogram(outputImage, static_cast<size_t>(width) * height, histogram);
+
+        scheduler->threshold = CalculateMinEdgeRatioThreshold(histogram, static_cast<size_t>(width) * height, scheduler->edgeRatio);
+
+        for (int index = 0; index < width * height; ++index)
+            outputImage[index] = (outputImage[index] <= scheduler->threshold) ? (0) : (255);
+    }
+    else
+    {
+        UnbiasEdge(inputImage, outputImage, imageSize, wsize);
+
+        if (degradations & DEGRADATION_SKIP_VARIANCE_GATE)
+            return degradations;
+
+        // Without the mean to recompute, the gate only needs the variance of the interior edge pixels.
+        if (degradations & DEGRADATION_PREVIOUS_THRESHOLD)
+        {
+            for (int iy = 0; iy < height; ++iy)
+                for (int ix = 0; ix < width; ++ix)
+                {
+                    const bool interior = iy >= wsize.cy / 2 && iy < height - wsize.cy / 2 && ix >= wsize.cx / 2 && ix < width - wsize.cx / 2;
+
+                    if (outputImage[iy * width + ix] == 0)
+                        outputImage[iy * width + ix] = (interior && CalculateWindowVariance(inputImage, imageSize, { ix, iy }, wsize) >= scheduler->threshold) ? (0) : (255);
+                    else
+                        outputImage[iy * width + ix] = 255;
+                }
+
+            return degradations;
+        }
+
+        double* varianceImage = new double[width * height];
+
+        CalculateLocalVariance(inputImage, varianceImage, imageSize, wsize);
+
+        scheduler->threshold = SumDeterministic(varianceImage, static_cast<size_t>(width) * height) / ((width - wsize.cx + 1) * (height - wsize.cy + 1));
+
+        for (int iy = 0; iy < height; ++iy)
+            for (int ix = 0; ix < width; ++ix)
+            {
+                const bool interior = iy >= wsize.cy / 2 && iy < height - wsize.cy / 2 && ix >= wsize.cx / 2 && ix < width - wsize.cx / 2;
+
+                outputImage[iy * width + ix] = (interior && varianceImage[iy * width + ix] >= scheduler->threshold && outputImage[iy * width + ix] == 0) ? (0) : (255);
+            }
+
+        delete[] varianceImage;
+    }
+
+    scheduler->thresholdValid        = true;
+    scheduler->thresholdDegradations = thresholdKey;
+
+    return degradations;
+}
+
+// Runs one frame at the best tier predicted to meet budgetMicroseconds, measured from the call, and feeds the
+// measured time back into the cost model. At the full tier the result equals the offline pipeline.
+RealtimeResult RunRealtimeFrame(RealtimeScheduler* scheduler, const byte_t* inputImage, byte_t* outputImage, const double budgetMicroseconds)
+{
+    assert(scheduler   != NULL);
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    RealtimeResult result;
+
+    result.tier         = SelectQualityTier(scheduler, budgetMicroseconds, &result.predictedMicroseconds);
+    result.degradations = scheduler->tierDegradations[result.tier];
+
+    if (result.degradations & DEGRADATION_DECIMATED_INPUT)
+    {
+        const int  width         = scheduler->imageSize.cx;
+        const int  height        = scheduler->imageSize.cy;
+        const SIZE decimatedSize = CalculateDecimatedSize(scheduler->imageSize);
+
+        byte_t* decimatedImage  = new byte_t[decimatedSize.cx * decimatedSize.cy];
+        byte_t* decimatedResult = new byte_t[decimatedSize.cx * decimatedSize.cy];
+
+        DecimateImage(inputImage, decimatedImage, scheduler->imageSize);
+
+        result.degradations = ComputeRealtimeFrame(scheduler, decimatedImage, decimatedResult, decimatedSize, result.degradations);
+
+        for (int iy = 0; iy < height; ++iy)
+            for (int ix = 0; ix < width; ++ix)
+                outputImage[iy * width + ix] = decimatedResult[(iy / 2) * decimatedSize.cx + ix / 2];
+
+        delete[] decimatedImage;
+        delete[] decimatedResult;
+    }
+    else
+        result.degradations = ComputeRealtimeFrame(scheduler, inputImage, outputImage, scheduler->imageSize, result.degradations);
+
+    result.elapsedMicroseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    result.deadlineMissed      = result.elapsedMicroseconds > budgetMicroseconds;
+
+    const double work = EstimateFrameWork(scheduler, result.degradations);
+
+    scheduler->tierCost[result.tier] = (scheduler->tierCost[result.tier] < 0.0) ? (result.elapsedMicroseconds) : (scheduler->tierCost[result.tier] + COST_SMOOTHING * (result.elapsedMicroseconds - scheduler->tierCost[result.tier]));
+    scheduler->costPerWork           = (scheduler->costPerWork < 0.0) ? (result.elapsedMicroseconds / work) : (scheduler->costPerWork + COST_SMOOTHING * (result.elapsedMicroseconds / work - scheduler->costPerWork));
+
+    for (int tier = 0; tier < scheduler->tierCount; ++tier)
+        if (tier != result.tier && scheduler->tierCost[tier] >= 0.0)
+            scheduler->tierCost[tier] += COST_AGING * (scheduler->costPerWork * EstimateFrameWork(scheduler, scheduler->tierDegradations[tier]) - scheduler->tierCost[tier]);
+
+    return result;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,71 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +-----------------------------------------< REALTIME SCHEDULER >-----------------------------------------+
+
+static const int MAX_QUALITY_TIER_COUNT = 8;
+
+enum RealtimeOperation
+{
+    REALTIME_ENTROPY_SKETCH_EDGE,   // EntropySketchEdge followed by MinEdgeRatioThreshold.
+    REALTIME_UNBIAS_THRESHOLD_EDGE  // UnbiasEdge followed by LocalVarianceThreshold.
+};
+
+// The quality reductions a tier may combine. A smaller window is 3x3; a decimated input is evaluated at half
+// resolution and its result scaled back up; a skipped variance gate leaves the plain unbias edges; a previous
+// threshold replaces the variance mean by the one of the last frame computed the same way, so the variance is
+// only evaluated at the unbias edge pixels the gate tests.
+enum QualityDegradation
+{
+    DEGRADATION_NONE               = 0x00,
+    DEGRADATION_SMALL_WINDOW       = 0x01,
+    DEGRADATION_DECIMATED_INPUT    = 0x02,
+    DEGRADATION_SKIP_VARIANCE_GATE = 0x04,
+    DEGRADATION_PREVIOUS_THRESHOLD = 0x08
+};
+
+// Tiers are ordered from full quality down; tierCost is the moving average of the measured frame time of each
+// tier in microseconds (negative until measured) and costPerWork the calibration used to predict the tiers
+// not measured yet. The costs of the tiers not run in a frame age toward the calibrated prediction, so a tier
+// priced out by one slow frame is tried again.
+struct RealtimeScheduler
+{
+    int    operation;
+    SIZE   imageSize;
+    SIZE   wsize;
+    double edgeRatio;
+
+    int    tierCount;
+    int    tierDegradations[MAX_QUALITY_TIER_COUNT];
+    double tierCost[MAX_QUALITY_TIER_COUNT];
+    double costPerWork;
+
+    bool   thresholdValid;
+    int    thresholdDegradations;
+    double threshold;
+};
+
+// degradations are the reductions actually applied, which for a previous threshold depends on whether one was
+// available.
+struct RealtimeResult
+{
+    int    tier;
+    int    degradations;
+    double predictedMicroseconds;
+    double elapsedMicroseconds;
+    bool   deadlineMissed;
+};
+
+RealtimeScheduler* CreateRealtimeScheduler(const int operation, SIZE imageSize, SIZE wsize, const double edgeRatio = 0.2);
+void               ReleaseRealtimeScheduler(RealtimeScheduler* scheduler);
+int                SelectQualityTier(const RealtimeScheduler* scheduler, const double budgetMicroseconds, double* predictedMicroseconds = NULL);
+RealtimeResult     RunRealtimeFrame(RealtimeScheduler* scheduler, const byte_t* inputImage, byte_t* outputImage, const double budgetMicroseconds);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,86 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Reduction.h"
+
+#include <cstring>
+
+// +---------------------------------------------< REDUCTION >----------------------------------------------+
+
+int CalculateReductionThreadCount(size_t count)
+{
+    return static_cast<int>(std::max<size_t>(1, std::min<size_t>(SelectThreadCount(), count / REDUCTION_MIN_THREAD_LENGTH)));
+}
+
+// 256-bin histogram accumulated into one private histogram per thread, merged afterwards.
+uint32_t* CalculateHistogram(const byte_t* values, const size_t count, uint32_t* histogram)
+{
+    assert(values    != NULL || count == 0);
+    assert(histogram != NULL);
+
+    const int threadCount = CalculateReductionThreadCount(count);
+
+    std::vector<uint32_t> threadHistograms(256 * threadCount, 0);
+
+    RunReductionThreads(threadCount, [&](int thread) {
+        uint32_t* localHistogram = &threadHistograms[256 * thread];
+
+        for (size_t index = count * thread / threadCount; index < count * (thread + 1) / threadCount; ++index)
+            localHistogram[values[index]]++;
+    });
+
+    memset(histogram, 0, sizeof(uint32_t) * 256);
+
+    for (int thread = 0; thread < threadCount; ++thread)
+        for (int bin = 0; bin < 256; ++bin)
+            histogram[bin] += threadHistograms[256 * thread + bin];
+
+    return histogram;
+}
+
+static double SumPairwise(const double* values, const size_t count)
+{
+    if (count == 1)
+        return values[0];
+
+    return SumPairwise(values, count / 2) + SumPairwise(values + count / 2, count - count / 2);
+}
+
+// Kahan-compensated sums over blocks of REDUCTION_BLOCK_SIZE values, combined by a pairwise tree whose shape
+// depends only on the block count.
+double SumDeterministic(const double* values, const size_t count)
+{
+    assert(values != NULL || count == 0);
+
+    if (count == 0)
+        return 0.0;
+
+    const size_t blockCount  = (count + REDUCTION_BLOCK_SIZE - 1) / REDUCTION_BLOCK_SIZE;
+    const int    threadCount = CalculateReductionThreadCount(count);
+
+    std::vector<double> blockSums(blockCount);
+
+    RunReductionThreads(threadCount, [&](int thread) {
+        for (size_t block = blockCount * thread / threadCount; block < blockCount * (thread + 1) / threadCount; ++block)
+        {
+            const size_t end = std::min(count, (block + 1) * REDUCTION_BLOCK_SIZE);
+
+            double sum          = 0.0;
+            double compensation = 0.0;
+
+            for (size_t index = block * REDUCTION_BLOCK_SIZE; index < end; ++index)
+            {
+                double term  = values[index] - compensation;
+                double total = sum + term;
+
+                compensation = (total - sum) - term;
+                sum          = total;
+            }
+
+            blockSums[block] = sum;
+        }
+    });
+
+    return SumPairwise(blockSums.data(), blockCount);
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,80 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Autotune.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+// +---------------------------------------------< REDUCTION >----------------------------------------------+
+
+// Every reduction splits its input into pieces whose boundaries depend only on the input length, never on the
+// thread count, and combines the partial results in a fixed order. Integer and min/max reductions are exact
+// anyway; for floating-point sums this makes the result bit-identical for any number of threads.
+static const size_t REDUCTION_BLOCK_SIZE        = 4096;
+static const size_t REDUCTION_MIN_THREAD_LENGTH = 65536;
+
+int CalculateReductionThreadCount(size_t count);
+
+// Calls function(threadIndex) on threadCount threads, the first one being the calling thread.
+template <typename function_t>
+void RunReductionThreads(const int threadCount, function_t function)
+{
+    assert(threadCount > 0);
+
+    std::vector<std::thread> threads;
+
+    for (int thread = 1; thread < threadCount; ++thread)
+        threads.push_back(std::thread(function, thread));
+
+    function(0);
+
+    for (size_t thread = 0; thread < threads.size(); ++thread)
+        threads[thread].join();
+}
+
+template <typename value_t>
+void ReduceMinMax(const value_t* values, const size_t count, value_t* minValue, value_t* maxValue)
+{
+    assert(values   != NULL);
+    assert(minValue != NULL);
+    assert(maxValue != NULL);
+    assert(count > 0);
+
+    const int threadCount = CalculateReductionThreadCount(count);
+
+    std::vector<value_t> threadMin(threadCount, values[0]);
+    std::vector<value_t> threadMax(threadCount, values[0]);
+
+    RunReductionThreads(threadCount, [&](int thread) {
+        const size_t begin = count * thread / threadCount;
+        const size_t end   = count * (thread + 1) / threadCount;
+
+        value_t localMin = values[begin];
+        value_t localMax = values[begin];
+
+        for (size_t index = begin + 1; index < end; ++index)
+        {
+            localMin = std::min(localMin, values[index]);
+            localMax = std::max(localMax, values[index]);
+        }
+
+        threadMin[thread] = localMin;
+        threadMax[thread] = localMax;
+    });
+
+    *minValue = *std::min_element(threadMin.begin(), threadMin.end());
+    *maxValue = *std::max_element(threadMax.begin(), threadMax.end());
+}
+
+uint32_t* CalculateHistogram(const byte_t* values, const size_t count, uint32_t* histogram);
+double    SumDeterministic(const double* values, const size_t count);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
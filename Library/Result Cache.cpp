@@ -0,0 +1,295 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#ifndef _CRT_SECURE_NO_WARNINGS
+    #define _CRT_SECURE_NO_WARNINGS
+#endif
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Result Cache.h"
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+// +------------------------------------------------< HASH >------------------------------------------------+
+
+static const uint64_t HASH_PRIME_1 = 0x9E3779B185EBCA87ULL;
+static const uint64_t HASH_PRIME_2 = 0xC2B2AE3D27D4EB4FULL;
+static const uint64_t HASH_PRIME_3 = 0x165667B19E3779F9ULL;
+static const uint64_t HASH_PRIME_4 = 0x85EBCA77C2B2AE63ULL;
+static const uint64_t HASH_PRIME_5 = 0x27D4EB2F165667C5ULL;
+
+static uint64_t RotateLeft(const uint64_t value, const int count)
+{
+    return (value << count) | (value >> (64 - count));
+}
+
+static uint64_t ReadHashWord(const byte_t* bytes)
+{
+    uint64_t word;
+
+    memcpy(&word, bytes, sizeof(word));
+
+    return word;
+}
+
+static uint32_t ReadHashHalfWord(const byte_t* bytes)
+{
+    uint32_t word;
+
+    memcpy(&word, bytes, sizeof(word));
+
+    return word;
+}
+
+static uint64_t HashRound(uint64_t accumulator, const uint64_t input)
+{
+    accumulator += input * HASH_PRIME_2;
+    accumulator  = RotateLeft(accumulator, 31);
+
+    return accumulator * HASH_PRIME_1;
+}
+
+static uint64_t MergeHashRound(uint64_t accumulator, const uint64_t value)
+{
+    accumulator ^= HashRound(0, value);
+
+    return accumulator * HASH_PRIME_1 + HASH_PRIME_4;
+}
+
+// XXH64 (little-endian hosts): four independent lanes over 32-byte stripes, so it runs at memory speed on
+// image-sized inputs while still mixing every byte into the whole digest.
+uint64_t HashBytes(const void* data, const size_t length, const uint64_t seed)
+{
+    assert(data != NULL || length == 0);
+
+    const byte_t* bytes = static_cast<const byte_t*>(data);
+    const byte_t* end   = bytes + length;
+    uint64_t      hash  = 0;
+
+    if (length >= 32)
+    {
+        uint64_t lanes[4] = { seed + HASH_PRIME_1 + HASH_PRIME_2, seed + HASH_PRIME_2, seed, seed - HASH_PRIME_1 };
+
+        for (; bytes + 32 <= end; bytes += 32)
+            for (int lane = 0; lane < 4; ++lane)
+                lanes[lane] = HashRound(lanes[lane], ReadHashWord(bytes + lane * 8));
+
+        hash = RotateLeft(lanes[0], 1) + RotateLeft(lanes[1], 7) + RotateLeft(lanes[2], 12) + RotateLeft(lanes[3], 18);
+
+        for (int lane = 0; lane < 4; ++lane)
+            hash = MergeHashRound(hash, lanes[lane]);
+    }
+    else
+        hash = seed + HASH_PRIME_5;
+
+    hash += static_cast<uint64_t>(length);
+
+    for (; bytes + 8 <= end; bytes += 8)
+        hash = RotateLeft(hash ^ HashRound(0, ReadHashWord(bytes)), 27) * HASH_PRIME_1 + HASH_PRIME_4;
+
+    if (bytes + 4 <= end)
+    {
+        hash   = RotateLeft(hash ^ (static_cast<uint64_t>(ReadHashHalfWord(bytes)) * HASH_PRIME_1), 23) * HASH_PRIME_2 + HASH_PRIME_3;
+        bytes += 4;
+    }
+
+    for (; bytes < end; ++bytes)
+        hash = RotateLeft(hash ^ (*bytes * HASH_PRIME_5), 11) * HASH_PRIME_1;
+
+    hash ^= hash >> 33;
+    hash *= HASH_PRIME_2;
+    hash ^= hash >> 29;
+    hash *= HASH_PRIME_3;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+// +--------------------------------------------< RESULT CACHE >--------------------------------------------+
+
+// The parameters are hashed in a canonical text form; unused ones are passed as zero.
+ResultCacheKey CreateResultCacheKey(const uint64_t inputHash, const char* operatorName, SIZE imageSize, SIZE wsize, const double edgeRatio, const double lamda)
+{
+    assert(operatorName != NULL);
+
+    char           description[256];
+    ResultCacheKey key;
+
+    snprintf(description, sizeof(description), "%u|%s|%dx%d|%dx%d|%.17g|%.17g", RESULT_CACHE_VERSION, operatorName, imageSize.cx, imageSize.cy, wsize.cx, wsize.cy, edgeRatio, lamda);
+
+    key.inputHash     = inputHash;
+    key.parameterHash = HashBytes(description, strlen(description));
+
+    return key;
+}
+
+static void CreateResultFileName(const char* cacheDirectory, ResultCacheKey key, char* fileName, const size_t fileNameSize)
+{
+    snprintf(fileName, fileNameSize, "%s/%016llx%016llx.result", cacheDirectory, static_cast<unsigned long long>(key.inputHash), static_cast<unsigned long long>(key.parameterHash));
+}
+
+// Writes to a temporary file renamed into place, so concurrent readers only ever see complete results.
+bool StoreCachedResult(const char* cacheDirectory, ResultCacheKey key, SIZE imageSize, const uint32_t elementSize, const void* data)
+{
+    assert(cacheDirectory != NULL);
+    assert(data           != NULL);
+
+    char fileName[1024];
+    char temporaryName[1040];
+
+    CreateResultFileName(cacheDirectory, key, fileName, sizeof(fileName));
+    snprintf(temporaryName, sizeof(temporaryName), "%s.partial", fileName);
+
+    ResultCacheHeader header;
+    byte_t            padding[RESULT_CACHE_DATA_OFFSET];
+
+    memset(&header, 0, sizeof(header));
+    memset(padding, 0, sizeof(padding));
+
+    header.magic       = RESULT_CACHE_MAGIC;
+    header.version     = RESULT_CACHE_VERSION;
+    header.key         = key;
+    header.width       = imageSize.cx;
+    header.height      = imageSize.cy;
+    header.elementSize = elementSize;
+    header.dataSize    = static_cast<uint64_t>(imageSize.cx) * imageSize.cy * elementSize;
+
+    FILE* fileStream = fopen(temporaryName, "wb");
+
+    if (fileStream == NULL)
+        return false;
+
+    bool succeeded = fwrite(&header, sizeof(header), 1, fileStream) == 1 &&
+                     fwrite(padding, RESULT_CACHE_DATA_OFFSET - sizeof(header), 1, fileStream) == 1 &&
+                     fwrite(data, 1, static_cast<size_t>(header.dataSize), fileStream) == header.dataSize;
+
+    succeeded = (fclose(fileStream) == 0) && succeeded;
+
+    if (succeeded)
+    {
+#if defined(_WIN32)
+        remove(fileName);
+#endif
+        succeeded = rename(temporaryName, fileName) == 0;
+    }
+
+    if (!succeeded)
+        remove(temporaryName);
+
+    return succeeded;
+}
+
+// Maps the cached result for key, or returns NULL if there is none or the file does not match the key. Where
+// mmap is unavailable the file is read into memory instead.
+CachedResult* MapCachedResult(const char* cacheDirectory, ResultCacheKey key)
+{
+    assert(cacheDirectory != NULL);
+
+    char fileName[1024];
+
+    CreateResultFileName(cacheDirectory, key, fileName, sizeof(fileName));
+
+    CachedResult* result = new CachedResult;
+
+    memset(result, 0, sizeof(CachedResult));
+
+#if !defined(_WIN32)
+    int         fileDescriptor = open(fileName, O_RDONLY | O_CLOEXEC);
+    struct stat status;
+
+    if (fileDescriptor < 0)
+    {
+        delete result;
+
+        return NULL;
+    }
+
+    if (fstat(fileDescriptor, &status) == 0 && static_cast<size_t>(status.st_size) >= RESULT_CACHE_DATA_OFFSET)
+    {
+        void* mapping = mmap(NULL, static_cast<size_t>(status.st_size), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+
+        if (mapping != MAP_FAILED)
+        {
+            result->mapping     = mapping;
+            result->mappingSize = static_cast<size_t>(status.st_size);
+        }
+    }
+
+    close(fileDescriptor);
+#else
+    FILE* fileStream = fopen(fileName, "rb");
+
+    if (fileStream == NULL)
+    {
+        delete result;
+
+        return NULL;
+    }
+
+    fseek(fileStream, 0, SEEK_END);
+    result->mappingSize = static_cast<size_t>(ftell(fileStream));
+    fseek(fileStream, 0, SEEK_SET);
+
+    if (result->mappingSize >= RESULT_CACHE_DATA_OFFSET)
+    {
+        result->mapping = new byte_t[result->mappingSize];
+
+        if (fread(result->mapping, 1, result->mappingSize, fileStream) != result->mappingSize)
+        {
+            delete[] static_cast<byte_t*>(result->mapping);
+            result->mapping = NULL;
+        }
+    }
+
+    fclose(fileStream);
+#endif
+
+    if (result->mapping == NULL)
+    {
+        delete result;
+
+        return NULL;
+    }
+
+    result->header = static_cast<const ResultCacheHeader*>(result->mapping);
+    result->data   = static_cast<const byte_t*>(result->mapping) + RESULT_CACHE_DATA_OFFSET;
+
+    const ResultCacheHeader* header = result->header;
+
+    if (header->magic != RESULT_CACHE_MAGIC || header->version != RESULT_CACHE_VERSION ||
+        header->key.inputHash != key.inputHash || header->key.parameterHash != key.parameterHash ||
+        header->dataSize != static_cast<uint64_t>(header->width) * header->height * header->elementSize ||
+        header->dataSize > result->mappingSize - RESULT_CACHE_DATA_OFFSET)
+    {
+        ReleaseCachedResult(result);
+
+        return NULL;
+    }
+
+    return result;
+}
+
+void ReleaseCachedResult(CachedResult* result)
+{
+    if (result == NULL)
+        return;
+
+#if !defined(_WIN32)
+    munmap(result->mapping, result->mappingSize);
+#else
+    delete[] static_cast<byte_t*>(result->mapping);
+#endif
+
+    delete result;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,56 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +------------------------------------------------< HASH >------------------------------------------------+
+
+uint64_t HashBytes(const void* data, const size_t length, const uint64_t seed = 0);
+
+// +--------------------------------------------< RESULT CACHE >--------------------------------------------+
+
+static const uint32_t RESULT_CACHE_MAGIC       = 0x43524546;
+static const uint32_t RESULT_CACHE_VERSION     = 1;
+static const size_t   RESULT_CACHE_DATA_OFFSET = 4096;
+
+// A result is identified by the hash of its input bytes and the hash of everything else that determines it:
+// the operator name, the image size and the operator parameters.
+struct ResultCacheKey
+{
+    uint64_t inputHash;
+    uint64_t parameterHash;
+};
+
+// Every cache file is this header followed, at RESULT_CACHE_DATA_OFFSET, by the result as stored in memory:
+// width * height elements of elementSize bytes. The page-aligned data can be used in place from a mapping.
+struct ResultCacheHeader
+{
+    uint32_t       magic;
+    uint32_t       version;
+    ResultCacheKey key;
+    int32_t        width;
+    int32_t        height;
+    uint32_t       elementSize;
+    uint32_t       reserved;
+    uint64_t       dataSize;
+};
+
+struct CachedResult
+{
+    void*                    mapping;
+    size_t                   mappingSize;
+    const ResultCacheHeader* header;
+    const void*              data;
+};
+
+ResultCacheKey CreateResultCacheKey(const uint64_t inputHash, const char* operatorName, SIZE imageSize, SIZE wsize, const double edgeRatio, const double lamda);
+bool           StoreCachedResult(const char* cacheDirectory, ResultCacheKey key, SIZE imageSize, const uint32_t elementSize, const void* data);
+CachedResult*  MapCachedResult(const char* cacheDirectory, ResultCacheKey key);
+void           ReleaseCachedResult(CachedResult* result);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,434 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Shard Coordinator.h"
+#include "Entropy Sketch.h"
+#include "Nonlinear Laplacian.h"
+#include "Sobel.h"
+#include "Utility.h"
+
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__linux__)
+
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#endif
+
+// +---------------------------------------------< SHARD PLAN >---------------------------------------------+
+
+// Sobel reads one row on each side; the windowed operators half a window, and the unbias zero crossings one
+// row more.
+int CalculateShardHalo(const int operation, SIZE wsize)
+{
+    assert(operation == SHARD_SOBEL_EDGE || operation == SHARD_ENTROPY_SKETCH_EDGE || operation == SHARD_UNBIAS_THRESHOLD_EDGE);
+
+    if (operation == SHARD_SOBEL_EDGE)
+        return 1;
+
+    if (operation == SHARD_ENTROPY_SKETCH_EDGE)
+        return wsize.cy / 2;
+
+    return wsize.cy / 2 + 1;
+}
+
+// Splits the rows into at most shardCount bands of nearly equal height, each at least 2 * halo + 1 rows so a
+// band with its halo is a valid image for the operation, and returns the number of bands.
+int PlanShardBands(SIZE imageSize, const int shardCount, const int halo, ShardBand* bands)
+{
+    assert(bands != NULL);
+    assert(shardCount >= 1);
+    assert(halo >= 0);
+
+    const int height    = imageSize.cy;
+    const int bandCount = std::max(1, std::min(std::min(shardCount, MAX_SHARD_COUNT), height / (2 * halo + 1)));
+
+    for (int band = 0; band < bandCount; ++band)
+    {
+        bands[band].top        = static_cast<int>(static_cast<int64_t>(height) * band / bandCount);
+        bands[band].bottom     = static_cast<int>(static_cast<int64_t>(height) * (band + 1) / bandCount);
+        bands[band].haloTop    = std::max(bands[band].top - halo, 0);
+        bands[band].haloBottom = std::min(bands[band].bottom + halo, height);
+    }
+
+    return bandCount;
+}
+
+// +-----------------------------------------< SHARD COORDINATOR >------------------------------------------+
+
+#if defined(__linux__)
+
+enum ShardCommand
+{
+    SHARD_COMMAND_EVALUATE = 1,
+    SHARD_COMMAND_NORMALIZE,
+    SHARD_COMMAND_THRESHOLD,
+    SHARD_COMMAND_EXIT
+};
+
+// Shared between the coordinator and one worker. The worker fills the partial statistics of its rows; the
+// coordinator writes back the merged ones before the next command.
+struct ShardControl
+{
+    double   minValue;
+    double   maxValue;
+    double   varianceSum;
+    uint32_t histogram[256];
+
+    double   globalMinValue;
+    double   globalMaxValue;
+    double   globalThreshold;
+};
+
+// The shard's memory holds the control block, the unnormalized values and the output of its rows, and its
+// input rows with halo. It is the only part of the image the worker sees, as it would be on another node.
+struct ShardTask
+{
+    ShardBand     band;
+    size_t        memorySize;
+    byte_t*       memory;
+    ShardControl* control;
+    double*       values;
+    byte_t*       outputRows;
+    byte_t*       inputRows;
+
+    pid_t         process;
+    int           socket;
+};
+
+struct ShardParameters
+{
+    SIZE imageSize;
+    int  operation;
+    SIZE wsize;
+};
+
+static size_t AlignShardOffset(size_t offset)
+{
+    return (offset + 63) / 64 * 64;
+}
+
+static bool CreateShardMemory(ShardTask* task, SIZE imageSize)
+{
+    const size_t width       = imageSize.cx;
+    const size_t rowCount    = task->band.bottom - task->band.top;
+    const size_t haloCount   = task->band.haloBottom - task->band.haloTop;
+    const size_t valueOffset = AlignShardOffset(sizeof(ShardControl));
+    const size_t rowOffset   = AlignShardOffset(valueOffset + sizeof(double) * width * rowCount);
+    const size_t inputOffset = AlignShardOffset(rowOffset + width * rowCount);
+
+    task->memorySize = inputOffset + width * haloCount;
+    task->memory     = static_cast<byte_t*>(mmap(NULL, task->memorySize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0));
+
+    if (task->memory == MAP_FAILED)
+    {
+        task->memory = NULL;
+
+        return false;
+    }
+
+    task->control    = reinterpret_cast<ShardControl*>(task->memory);
+    task->values     = reinterpret_cast<double*>(task->memory + valueOffset);
+    task->outputRows = task->memory + rowOffset;
+    task->inputRows  = task->memory + inputOffset;
+
+    return true;
+}
+
+// Runs the operation on the band with its halo as an image of its own and keeps the rows of the band. Rows
+// within the halo of the band's edges are wrong in that image unless they are image borders, which is why the
+// halo is sized to what the operation reads.
+static void EvaluateShard(const ShardTask* task, const ShardParameters* parameters)
+{
+    const int    width      = parameters->imageSize.cx;
+    const SIZE   haloSize   = { width, task->band.haloBottom - task->band.haloTop };
+    const size_t haloCount  = static_cast<size_t>(haloSize.cx) * haloSize.cy;
+    const size_t rowOffset  = static_cast<size_t>(task->band.top - task->band.haloTop) * width;
+    const size_t pixelCount = static_cast<size_t>(task->band.bottom - task->band.top) * width;
+
+    double* haloValues = new double[haloCount];
+
+    if (parameters->operation == SHARD_SOBEL_EDGE)
+    {
+        mag_t* magnitudeX = new mag_t[haloCount];
+        mag_t* magnitudeY = new mag_t[haloCount];
+
+        Sobel(task->inputRows, magnitudeX, haloSize, SOBEL_X);
+        Sobel(task->inputRows, magnitudeY, haloSize, SOBEL_Y);
+
+        for (size_t index = 0; index < haloCount; ++index)
+            haloValues[index] = abs(magnitudeX[index]) + abs(magnitudeY[index]);
+
+        delete[] magnitudeX;
+        delete[] magnitudeY;
+    }
+    else if (parameters->operation == SHARD_ENTROPY_SKETCH_EDGE)
+    {
+        lbyte_t* integralImage = new lbyte_t[haloCount];
+
+        CreateIntegralImage(task->inputRows, integralImage, haloSize);
+        CalculateEntropySketch(task->inputRows, haloValues, haloSize, parameters->wsize, integralImage);
+
+        delete[] integralImage;
+    }
+    else
+    {
+        byte_t* unbiasEdgeImage = new byte_t[haloCount];
+
+        UnbiasEdge(task->inputRows, unbiasEdgeImage, haloSize, parameters->wsize);
+        CalculateLocalVariance(task->inputRows, haloValues, haloSize, parameters->wsize);
+
+        memcpy(task->outputRows, unbiasEdgeImage + rowOffset, sizeof(byte_t) * pixelCount);
+
+        delete[] unbiasEdgeImage;
+    }
+
+    memcpy(task->values, haloValues + rowOffset, sizeof(double) * pixelCount);
+
+    ReduceMinMax(task->values, pixelCount, &task->control->minValue, &task->control->maxValue);
+
+    task->control->varianceSum = SumDeterministic(task->values, pixelCount);
+
+    delete[] haloValues;
+}
+
+static void NormalizeShard(const ShardTask* task, const ShardParameters* parameters)
+{
+    const size_t pixelCount = static_cast<size_t>(task->band.bottom - task->band.top) * parameters->imageSize.cx;
+    const double minValue   = task->control->globalMinValue;
+    const double maxValue   = task->control->globalMaxValue;
+
+    for (size_t index = 0; index < pixelCount; ++index)
+        task->outputRows[index] = NormalizeValue(task->values[index], minValue, maxValue);
+
+    CalculateHistogram(task->outputRows, pixelCount, task->control->histogram);
+}
+
+static void ThresholdShard(const ShardTask* task, const ShardParameters* parameters)
+{
+    const int    width     = parameters->imageSize.cx;
+    const int    height    = parameters->imageSize.cy;
+    const SIZE   wsize     = parameters->wsize;
+    const double threshold = task->control->globalThreshold;
+
+    for (int iy = task->band.top; iy < task->band.bottom; ++iy)
+        for (int ix = 0; ix < width; ++ix)
+        {
+            const size_t index = static_cast<size_t>(iy - task->band.top) * width + ix;
+
+            if (parameters->operation == SHARD_SOBEL_EDGE)
+                task->outputRows[index] = (task->outputRows[index] >= threshold) ? (0) : (255);
+            else if (parameters->operation == SHARD_ENTROPY_SKETCH_EDGE)
+                task->outputRows[index] = (task->outputRows[index] <= threshold) ? (0) : (255);
+            else
+            {
+                const bool interior = iy >= wsize.cy / 2 && iy < height - wsize.cy / 2 && ix >= wsize.cx / 2 && ix < width - wsize.cx / 2;
+
+                task->outputRows[index] = (interior && task->values[index] >= threshold && task->outputRows[index] == 0) ? (0) : (255);
+            }
+        }
+}
+
+static void RunShardWorker(const ShardTask* task, const ShardParameters* parameters)
+{
+    byte_t command;
+
+    while (recv(task->socket, &command, sizeof(command), 0) == sizeof(command) && command != SHARD_COMMAND_EXIT)
+    {
+        if (command == SHARD_COMMAND_EVALUATE)
+            EvaluateShard(task, parameters);
+        else if (command == SHARD_COMMAND_NORMALIZE)
+            NormalizeShard(task, parameters);
+        else if (command == SHARD_COMMAND_THRESHOLD)
+            ThresholdShard(task, parameters);
+
+        if (send(task->socket, &command, sizeof(command), MSG_NOSIGNAL) != sizeof(command))
+            break;
+    }
+}
+
+// Sends command to every worker and waits for all of them to acknowledge it; false if a worker is gone.
+static bool BroadcastShardCommand(ShardTask* tasks, const int taskCount, byte_t command)
+{
+    bool succeeded = true;
+
+    for (int task = 0; task < taskCount; ++task)
+        succeeded &= send(tasks[task].socket, &command, sizeof(command), MSG_NOSIGNAL) == sizeof(command);
+
+    for (int task = 0; task < taskCount && succeeded; ++task)
+    {
+        byte_t reply = 0;
+
+        succeeded &= recv(tasks[task].socket, &reply, sizeof(reply), 0) == sizeof(reply) && reply == command;
+    }
+
+    return succeeded;
+}
+
+static bool StartShardWorker(ShardTask* task, const ShardParameters* parameters)
+{
+    int sockets[2];
+
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sockets) != 0)
+        return false;
+
+    task->process = fork();
+
+    if (task->process == 0)
+    {
+        close(sockets[0]);
+        task->socket = sockets[1];
+
+        RunShardWorker(task, parameters);
+
+        _exit(0);
+    }
+
+    close(sockets[1]);
+    task->socket = sockets[0];
+
+    if (task->process < 0)
+    {
+        close(task->socket);
+        task->socket = -1;
+
+        return false;
+    }
+
+    return true;
+}
+
+static void StopShardWorkers(ShardTask* tasks, const int taskCount)
+{
+    const byte_t command = SHARD_COMMAND_EXIT;
+
+    for (int task = 0; task < taskCount; ++task)
+    {
+        if (tasks[task].socket >= 0)
+        {
+            send(tasks[task].socket, &command, sizeof(command), MSG_NOSIGNAL);
+            close(tasks[task].socket);
+        }
+
+        if (tasks[task].process > 0)
+            waitpid(tasks[task].process, NULL, 0);
+
+        if (tasks[task].memory != NULL)
+            munmap(tasks[task].memory, tasks[task].memorySize);
+    }
+}
+
+// The coordinator splits the image into bands, copies every band with its halo rows into the shared memory of
+// a forked worker and drives the workers through the stages of the operation. Between stages it merges their
+// partial statistics, in shard order, into the global ones: the normalization range, the threshold histogram
+// and the variance sum. Min, max and histogram merges are exact, so the edge pipelines equal the single-process
+// ones; the variance mean is the sum of per-shard sums and may differ from it in the last bits. Returns NULL
+// if the shared memory or a worker process could not be created, or a worker died.
+byte_t* RunShardedOperation(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int operation, SIZE wsize, const double edgeRatio, const int shardCount)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    const int             width      = imageSize.cx;
+    const int             height     = imageSize.cy;
+    const ShardParameters parameters = { imageSize, operation, wsize };
+
+    ShardBand bands[MAX_SHARD_COUNT];
+    ShardTask tasks[MAX_SHARD_COUNT];
+    int       taskCount = PlanShardBands(imageSize, shardCount, CalculateShardHalo(operation, wsize), bands);
+    bool      succeeded = true;
+
+    memset(tasks, 0, sizeof(tasks));
+
+    for (int task = 0; task < taskCount; ++task)
+    {
+        tasks[task].band   = bands[task];
+        tasks[task].socket = -1;
+    }
+
+    for (int task = 0; task < taskCount && succeeded; ++task)
+    {
+        const ShardBand* band = &tasks[task].band;
+
+        succeeded = CreateShardMemory(&tasks[task], imageSize);
+
+        if (succeeded)
+        {
+            memcpy(tasks[task].inputRows, inputImage + static_cast<size_t>(band->haloTop) * width, sizeof(byte_t) * width * (band->haloBottom - band->haloTop));
+
+            succeeded = StartShardWorker(&tasks[task], &parameters);
+        }
+    }
+
+    succeeded = succeeded && BroadcastShardCommand(tasks, taskCount, SHARD_COMMAND_EVALUATE);
+
+    if (succeeded && operation != SHARD_UNBIAS_THRESHOLD_EDGE)
+    {
+        double   minValue = tasks[0].control->minValue;
+        double   maxValue = tasks[0].control->maxValue;
+        uint32_t histogram[256];
+
+        for (int task = 1; task < taskCount; ++task)
+        {
+            minValue = std::min(minValue, tasks[task].control->minValue);
+            maxValue = std::max(maxValue, tasks[task].control->maxValue);
+        }
+
+        for (int task = 0; task < taskCount; ++task)
+        {
+            tasks[task].control->globalMinValue = minValue;
+            tasks[task].control->globalMaxValue = maxValue;
+        }
+
+        succeeded = BroadcastShardCommand(tasks, taskCount, SHARD_COMMAND_NORMALIZE);
+
+        memset(histogram, 0, sizeof(histogram));
+
+        for (int task = 0; task < taskCount && succeeded; ++task)
+            for (int brightness = 0; brightness < 256; ++brightness)
+                histogram[brightness] += tasks[task].control->histogram[brightness];
+
+        const size_t pixelCount = static_cast<size_t>(width) * height;
+        const int    threshold  = (operation == SHARD_SOBEL_EDGE) ? (CalculateMaxEdgeRatioThreshold(histogram, pixelCount, edgeRatio)) : (CalculateMinEdgeRatioThreshold(histogram, pixelCount, edgeRatio));
+
+        for (int task = 0; task < taskCount; ++task)
+            tasks[task].control->globalThreshold = threshold;
+    }
+    else if (succeeded)
+    {
+        double varianceSum = 0.0;
+
+        for (int task = 0; task < taskCount; ++task)
+            varianceSum += tasks[task].control->varianceSum;
+
+        for (int task = 0; task < taskCount; ++task)
+            tasks[task].control->globalThreshold = varianceSum / ((width - wsize.cx + 1) * (height - wsize.cy + 1));
+    }
+
+    succeeded = succeeded && BroadcastShardCommand(tasks, taskCount, SHARD_COMMAND_THRESHOLD);
+
+    for (int task = 0; task < taskCount && succeeded; ++task)
+        memcpy(outputImage + static_cast<size_t>(tasks[task].band.top) * width, tasks[task].outputRows, sizeof(byte_t) * width * (tasks[task].band.bottom - tasks[task].band.top));
+
+    StopShardWorkers(tasks, taskCount);
+
+    return (succeeded) ? (outputImage) : (NULL);
+}
+
+#else
+
+byte_t* RunShardedOperation(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int operation, SIZE wsize, const double edgeRatio, const int shardCount)
+{
+    return NULL;
+}
+
+#endif
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,37 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <cstddef>
+
+// +-----------------------------------------< SHARD COORDINATOR >------------------------------------------+
+
+static const int MAX_SHARD_COUNT = 64;
+
+// The sharded operations are the complete pipelines of the drivers, global statistics included.
+enum ShardOperation
+{
+    SHARD_SOBEL_EDGE,           // SobelEdge followed by MaxEdgeRatioThreshold.
+    SHARD_ENTROPY_SKETCH_EDGE,  // EntropySketchEdge followed by MinEdgeRatioThreshold.
+    SHARD_UNBIAS_THRESHOLD_EDGE // UnbiasEdge followed by LocalVarianceThreshold.
+};
+
+// A shard computes the rows [top, bottom) and holds the input rows [haloTop, haloBottom), its rows plus the
+// halo its operation reads from the neighboring bands.
+struct ShardBand
+{
+    int top;
+    int bottom;
+    int haloTop;
+    int haloBottom;
+};
+
+int     CalculateShardHalo(const int operation, SIZE wsize);
+int     PlanShardBands(SIZE imageSize, const int shardCount, const int halo, ShardBand* bands);
+byte_t* RunShardedOperation(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const int operation, SIZE wsize, const double edgeRatio, const int shardCount);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
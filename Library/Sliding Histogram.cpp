@@ -0,0 +1,157 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Sliding Histogram.h"
+#include "Utility.h"
+
+#include <cmath>
+
+// +-----------------------------------------< SLIDING HISTOGRAM >------------------------------------------+
+
+// The value of the rank-th smallest pixel, counting from 0.
+byte_t SelectHistogramRank(const uint32_t* histogram, const uint32_t rank)
+{
+    assert(histogram != NULL);
+
+    uint32_t histogramCount = 0;
+
+    for (int brightness = 0; brightness < 256; ++brightness)
+        if ((histogramCount += histogram[brightness]) > rank)
+            return static_cast<byte_t>(brightness);
+
+    return 255;
+}
+
+// Otsu's threshold: the brightness t maximizing the between-class variance of [0, t] and [t + 1, 255].
+byte_t CalculateOtsuThreshold(const uint32_t* histogram, const size_t pixelCount)
+{
+    assert(histogram != NULL);
+
+    double totalSum = 0.0;
+
+    for (int brightness = 0; brightness < 256; ++brightness)
+        totalSum += static_cast<double>(brightness) * histogram[brightness];
+
+    double lowerCount  = 0.0;
+    double lowerSum    = 0.0;
+    double maxVariance = -1.0;
+    byte_t threshold   = 0;
+
+    for (int brightness = 0; brightness < 256; ++brightness)
+    {
+        lowerCount += histogram[brightness];
+        lowerSum   += static_cast<double>(brightness) * histogram[brightness];
+
+        const double upperCount = pixelCount - lowerCount;
+
+        if (lowerCount == 0.0 || upperCount == 0.0)
+            continue;
+
+        const double meanDifference = lowerSum / lowerCount - (totalSum - lowerSum) / upperCount;
+        const double variance       = lowerCount * upperCount * meanDifference * meanDifference;
+
+        if (variance > maxVariance)
+        {
+            maxVariance = variance;
+            threshold   = static_cast<byte_t>(brightness);
+        }
+    }
+
+    return threshold;
+}
+
+// +------------------------------------------< LOCAL THRESHOLD >-------------------------------------------+
+
+// Every local operator evaluates the window clipped to the image, so the border is handled like the interior.
+
+byte_t* LocalMedian(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(inputImage  != outputImage);
+
+    const int width = imageSize.cx;
+
+    ForEachSlidingHistogram(inputImage, imageSize, wsize, [&](int ix, int iy, const SlidingHistogram* histogram) {
+        outputImage[iy * width + ix] = SelectHistogramRank(histogram->bins, histogram->pixelCount / 2);
+    });
+
+    return outputImage;
+}
+
+// Pixels at or above the given percentile (0 to 1) of their window are edges.
+byte_t* LocalPercentileThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const double percentile)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(inputImage  != outputImage);
+    assert(percentile >= 0.0 && percentile <= 1.0);
+
+    const int width = imageSize.cx;
+
+    ForEachSlidingHistogram(inputImage, imageSize, wsize, [&](int ix, int iy, const SlidingHistogram* histogram) {
+        const uint32_t rank      = std::min(static_cast<uint32_t>(percentile * histogram->pixelCount), histogram->pixelCount - 1);
+        const byte_t   threshold = SelectHistogramRank(histogram->bins, rank);
+
+        outputImage[iy * width + ix] = (inputImage[iy * width + ix] >= threshold) ? (0) : (255);
+    });
+
+    return outputImage;
+}
+
+// Pixels above the Otsu threshold of their window are edges.
+byte_t* LocalOtsuThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(inputImage  != outputImage);
+
+    const int width = imageSize.cx;
+
+    ForEachSlidingHistogram(inputImage, imageSize, wsize, [&](int ix, int iy, const SlidingHistogram* histogram) {
+        const byte_t threshold = CalculateOtsuThreshold(histogram->bins, histogram->pixelCount);
+
+        outputImage[iy * width + ix] = (inputImage[iy * width + ix] > threshold) ? (0) : (255);
+    });
+
+    return outputImage;
+}
+
+// MaxEdgeRatioThreshold with the threshold taken from each pixel's window instead of the whole image.
+byte_t* LocalMaxEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const double edgeRatio)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(inputImage  != outputImage);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    const int width = imageSize.cx;
+
+    ForEachSlidingHistogram(inputImage, imageSize, wsize, [&](int ix, int iy, const SlidingHistogram* histogram) {
+        const int threshold = CalculateMaxEdgeRatioThreshold(histogram->bins, histogram->pixelCount, edgeRatio);
+
+        outputImage[iy * width + ix] = (inputImage[iy * width + ix] >= threshold) ? (0) : (255);
+    });
+
+    return outputImage;
+}
+
+// MinEdgeRatioThreshold with the threshold taken from each pixel's window instead of the whole image.
+byte_t* LocalMinEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const double edgeRatio)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(inputImage  != outputImage);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    const int width = imageSize.cx;
+
+    ForEachSlidingHistogram(inputImage, imageSize, wsize, [&](int ix, int iy, const SlidingHistogram* histogram) {
+        const int threshold = CalculateMinEdgeRatioThreshold(histogram->bins, histogram->pixelCount, edgeRatio);
+
+        outputImage[iy * width + ix] = (inputImage[iy * width + ix] <= threshold) ? (0) : (255);
+    });
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
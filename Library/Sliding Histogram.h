@@ -0,0 +1,98 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+// +-----------------------------------------< SLIDING HISTOGRAM >------------------------------------------+
+
+// The histogram of the window around one pixel. Windows are clipped to the image, so pixelCount is smaller
+// than wsize.cx * wsize.cy near the border.
+struct SlidingHistogram
+{
+    uint32_t pixelCount;
+    uint32_t bins[256];
+};
+
+// Calls function(ix, iy, histogram) for every pixel in raster order with the histogram of its window, kept with
+// Perreault and Hebert's column histograms: each column keeps the histogram of the window height and moves down
+// one pixel per row, and the window histogram moves right by adding the column entering it and subtracting the
+// one leaving it. The cost per pixel is a fixed 256-bin update whatever the window size.
+template <typename function_t>
+void ForEachSlidingHistogram(const byte_t* image, SIZE imageSize, SIZE wsize, function_t function)
+{
+    assert(image != NULL);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+    assert(wsize.cy <= UINT16_MAX);
+
+    const int width   = imageSize.cx;
+    const int height  = imageSize.cy;
+    const int radiusX = wsize.cx / 2;
+    const int radiusY = wsize.cy / 2;
+
+    uint16_t*        columns   = new uint16_t[static_cast<size_t>(width) * 256];
+    SlidingHistogram histogram;
+
+    memset(columns, 0, sizeof(uint16_t) * width * 256);
+
+    for (int iy = 0; iy < std::min(radiusY, height); ++iy)
+        for (int ix = 0; ix < width; ++ix)
+            ++columns[ix * 256 + image[iy * width + ix]];
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        if (iy + radiusY < height)
+            for (int ix = 0; ix < width; ++ix)
+                ++columns[ix * 256 + image[(iy + radiusY) * width + ix]];
+
+        if (iy - radiusY - 1 >= 0)
+            for (int ix = 0; ix < width; ++ix)
+                --columns[ix * 256 + image[(iy - radiusY - 1) * width + ix]];
+
+        const uint32_t rowCount = std::min(height, iy + radiusY + 1) - std::max(0, iy - radiusY);
+
+        memset(histogram.bins, 0, sizeof(histogram.bins));
+
+        for (int ix = 0; ix < std::min(radiusX, width); ++ix)
+            for (int bin = 0; bin < 256; ++bin)
+                histogram.bins[bin] += columns[ix * 256 + bin];
+
+        for (int ix = 0; ix < width; ++ix)
+        {
+            if (ix + radiusX < width)
+                for (int bin = 0; bin < 256; ++bin)
+                    histogram.bins[bin] += columns[(ix + radiusX) * 256 + bin];
+
+            if (ix - radiusX - 1 >= 0)
+                for (int bin = 0; bin < 256; ++bin)
+                    histogram.bins[bin] -= columns[(ix - radiusX - 1) * 256 + bin];
+
+            histogram.pixelCount = rowCount * (std::min(width, ix + radiusX + 1) - std::max(0, ix - radiusX));
+
+            function(ix, iy, static_cast<const SlidingHistogram*>(&histogram));
+        }
+    }
+
+    delete[] columns;
+}
+
+byte_t  SelectHistogramRank(const uint32_t* histogram, const uint32_t rank);
+byte_t  CalculateOtsuThreshold(const uint32_t* histogram, const size_t pixelCount);
+
+// +------------------------------------------< LOCAL THRESHOLD >-------------------------------------------+
+
+byte_t* LocalMedian(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+byte_t* LocalPercentileThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const double percentile);
+byte_t* LocalOtsuThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize);
+byte_t* LocalMaxEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const double edgeRatio = 0.2);
+byte_t* LocalMinEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, SIZE wsize, const double edgeRatio = 0.2);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
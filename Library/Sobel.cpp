@@ -0,0 +1,631 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Sobel.h"
+#include "Utility.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+// +-----------------------------------------------< SOBEL >------------------------------------------------+
+
+const ConvolutionKernel SOBEL_KERNEL_X = CreateSobelKernel(SOBEL_X);
+const ConvolutionKernel SOBEL_KERNEL_Y = CreateSobelKernel(SOBEL_Y);
+
+static ConvolutionKernel CreateDirectKernel(const ConvolutionKernel* kernel)
+{
+    ConvolutionKernel directKernel = *kernel;
+
+    directKernel.rank = 0;
+
+    return directKernel;
+}
+
+static const ConvolutionKernel SOBEL_DIRECT_KERNEL_X = CreateDirectKernel(&SOBEL_KERNEL_X);
+static const ConvolutionKernel SOBEL_DIRECT_KERNEL_Y = CreateDirectKernel(&SOBEL_KERNEL_Y);
+
+// Both variants give identical results; the direct one skips the separable row/column passes, which only pay
+// off on some machines for a 3x3 kernel.
+const ConvolutionKernel* SelectSobelKernel(const int direction, const int variant)
+{
+    assert(direction == SOBEL_X || direction == SOBEL_Y);
+
+    if (variant == CONVOLUTION_VARIANT_DIRECT)
+        return (direction == SOBEL_X) ? (&SOBEL_DIRECT_KERNEL_X) : (&SOBEL_DIRECT_KERNEL_Y);
+
+    return (direction == SOBEL_X) ? (&SOBEL_KERNEL_X) : (&SOBEL_KERNEL_Y);
+}
+
+mag_t* Sobel(const byte_t* inputImage, mag_t* sobelImage, SIZE imageSize, const int direction)
+{
+    assert(inputImage != NULL);
+    assert(sobelImage != NULL);
+    assert(direction == SOBEL_X || direction == SOBEL_Y);
+
+    return Convolve(inputImage, sobelImage, imageSize, SelectSobelKernel(direction, GetTuningProfile()->sobelVariant));
+}
+
+// Gradients of a camera frame, read in place or converted to luma within the convolution row pass.
+mag_t* Sobel(const ImageSource* source, mag_t* sobelImage, const int direction)
+{
+    assert(source     != NULL);
+    assert(sobelImage != NULL);
+    assert(direction == SOBEL_X || direction == SOBEL_Y);
+
+    return Convolve(source, sobelImage, SelectSobelKernel(direction, GetTuningProfile()->sobelVariant));
+}
+
+byte_t* SobelEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    mag_t* magnitudeX = new mag_t[width * height];
+    mag_t* magnitudeY = new mag_t[width * height];
+
+    Sobel(inputImage, magnitudeX, imageSize, SOBEL_X);
+    Sobel(inputImage, magnitudeY, imageSize, SOBEL_Y);
+
+    GradientMagnitudeEdge(magnitudeX, magnitudeY, outputImage, imageSize);
+
+    delete[] magnitudeX;
+    delete[] magnitudeY;
+
+    return outputImage;
+}
+
+// Equal to SobelEdge on the packed luma of the source. Each direction converts RGB rows on its own, which
+// costs less than writing and rereading a full gray copy.
+byte_t* SobelEdge(const ImageSource* source, byte_t* outputImage)
+{
+    assert(source      != NULL);
+    assert(outputImage != NULL);
+
+    const int width  = source->imageSize.cx;
+    const int height = source->imageSize.cy;
+
+    mag_t* magnitudeX = new mag_t[width * height];
+    mag_t* magnitudeY = new mag_t[width * height];
+
+    Sobel(source, magnitudeX, SOBEL_X);
+    Sobel(source, magnitudeY, SOBEL_Y);
+
+    GradientMagnitudeEdge(magnitudeX, magnitudeY, outputImage, source->imageSize);
+
+    delete[] magnitudeX;
+    delete[] magnitudeY;
+
+    return outputImage;
+}
+
+// The normalized L1 gradient magnitude |gx| + |gy| of precomputed Sobel gradients.
+byte_t* GradientMagnitudeEdge(const mag_t* magnitudeX, const mag_t* magnitudeY, byte_t* outputImage, SIZE imageSize)
+{
+    assert(magnitudeX  != NULL);
+    assert(magnitudeY  != NULL);
+    assert(outputImage != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    mag_t* sobelImage = new mag_t[width * height];
+
+    memset(outputImage, 255, sizeof(byte_t) * width * height);
+
+    for (int iy = 0; iy < height; ++iy)
+        for (int ix = 0; ix < width; ++ix)
+            sobelImage[iy * width + ix] = abs(magnitudeX[iy * width + ix]) + abs(magnitudeY[iy * width + ix]);
+
+    Normalization(sobelImage, outputImage, imageSize);
+
+    delete[] sobelImage;
+
+    return outputImage;
+}
+
+// Edge maps of every pyramid level from the cached gradients.
+ScaleSpaceMap* SobelEdgePyramid(ImagePyramid* pyramid)
+{
+    assert(pyramid != NULL);
+
+    ScaleSpaceMap* map = CreateScaleSpaceMap(pyramid);
+
+    for (int level = 0; level < pyramid->levelCount; ++level)
+    {
+        const PyramidLevel* current = RequirePyramidLevel(pyramid, level, PYRAMID_GRADIENT);
+
+        GradientMagnitudeEdge(current->magnitudeX, current->magnitudeY, map->images[level], current->imageSize);
+    }
+
+    return map;
+}
+
+// With a tileMask (TILE_SIZE tiles, as laid out by CalculateTileCount) gradients are only computed in the
+// selected tiles and the others get zero magnitude before the normalization.
+byte_t* SobelEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const bool* tileMask)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    if (tileMask == NULL)
+        return SobelEdge(inputImage, outputImage, imageSize);
+
+    const int  width        = imageSize.cx;
+    const int  height       = imageSize.cy;
+    const SIZE tileCount    = CalculateTileCount(imageSize);
+    const RECT interiorRect = { 1, 1, width - 1, height - 1 };
+
+    mag_t* sobelImage = new mag_t[width * height];
+    mag_t* magnitudeX = new mag_t[width * height];
+    mag_t* magnitudeY = new mag_t[width * height];
+
+    memset(outputImage, 255, sizeof(byte_t) * width * height);
+    memset(sobelImage, 0, sizeof(mag_t) * width * height);
+
+    for (int ty = 0; ty < tileCount.cy; ++ty)
+        for (int tx = 0; tx < tileCount.cx; ++tx)
+        {
+            if (!tileMask[ty * tileCount.cx + tx])
+                continue;
+
+            RECT region = CalculateTileRect(tx, ty, { 0, 0 }, interiorRect);
+
+            ConvolveRegion(inputImage, magnitudeX, imageSize, SelectSobelKernel(SOBEL_X, GetTuningProfile()->sobelVariant), region);
+            ConvolveRegion(inputImage, magnitudeY, imageSize, SelectSobelKernel(SOBEL_Y, GetTuningProfile()->sobelVariant), region);
+
+            for (int iy = region.top; iy < region.bottom; ++iy)
+                for (int ix = region.left; ix < region.right; ++ix)
+                    sobelImage[iy * width + ix] = abs(magnitudeX[iy * width + ix]) + abs(magnitudeY[iy * width + ix]);
+        }
+
+    Normalization(sobelImage, outputImage, imageSize);
+
+    delete[] sobelImage;
+    delete[] magnitudeX;
+    delete[] magnitudeY;
+
+    return outputImage;
+}
+
+// +----------------------------------< HISTOGRAM OF ORIENTED GRADIENTS >-----------------------------------+
+
+// Every pixel votes its gradient magnitude into the two unsigned orientation bins nearest to its gradient
+// direction, linearly weighted by the distance to the bin centers.
+IntegralHistogram* CreateIntegralHistogram(const mag_t* magnitudeX, const mag_t* magnitudeY, SIZE imageSize, const int binCount)
+{
+    assert(magnitudeX != NULL);
+    assert(magnitudeY != NULL);
+    assert(binCount > 0 && binCount <= MAX_HOG_BIN_COUNT);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    IntegralHistogram* histogram = new IntegralHistogram;
+    double             rowSum[MAX_HOG_BIN_COUNT];
+
+    histogram->imageSize = imageSize;
+    histogram->binCount  = binCount;
+    histogram->bins      = new double[(width + 1) * (height + 1) * binCount];
+
+    memset(histogram->bins, 0, sizeof(double) * (width + 1) * binCount);
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        double* previousRow = histogram->bins + (iy * (width + 1)) * binCount;
+        double* currentRow  = histogram->bins + ((iy + 1) * (width + 1)) * binCount;
+
+        memset(rowSum, 0, sizeof(double) * binCount);
+        memset(currentRow, 0, sizeof(double) * binCount);
+
+        for (int ix = 0; ix < width; ++ix)
+        {
+            double gradientX = magnitudeX[iy * width + ix];
+            double gradientY = magnitudeY[iy * width + ix];
+            double magnitude = sqrt(gradientX * gradientX + gradientY * gradientY);
+
+            if (magnitude > 0.0)
+            {
+                double orientation = atan2(gradientY, gradientX) * 180.0 / PI;
+
+                if (orientation < 0.0)
+                    orientation += 180.0;
+
+                double position  = orientation * binCount / 180.0 - 0.5;
+                int    lowerBin  = static_cast<int>(floor(position));
+                double upperPart = position - lowerBin;
+
+                rowSum[(lowerBin + binCount) % binCount] += magnitude * (1.0 - upperPart);
+                rowSum[(lowerBin + 1) % binCount]        += magnitude * upperPart;
+            }
+
+            for (int bin = 0; bin < binCount; ++bin)
+                currentRow[(ix + 1) * binCount + bin] = previousRow[(ix + 1) * binCount + bin] + rowSum[bin];
+        }
+    }
+
+    return histogram;
+}
+
+void ReleaseIntegralHistogram(IntegralHistogram* histogram)
+{
+    assert(histogram != NULL);
+
+    delete[] histogram->bins;
+    delete histogram;
+}
+
+double* CalculateRectHistogram(const IntegralHistogram* integralHistogram, RECT rect, double* histogram)
+{
+    assert(integralHistogram != NULL);
+    assert(histogram         != NULL);
+    assert(rect.left >= 0 && rect.right <= integralHistogram->imageSize.cx && rect.left <= rect.right);
+    assert(rect.top >= 0 && rect.bottom <= integralHistogram->imageSize.cy && rect.top <= rect.bottom);
+
+    const int     binCount    = integralHistogram->binCount;
+    const int     stride      = integralHistogram->imageSize.cx + 1;
+    const double* topLeft     = integralHistogram->bins + (rect.top * stride + rect.left) * binCount;
+    const double* topRight    = integralHistogram->bins + (rect.top * stride + rect.right) * binCount;
+    const double* bottomLeft  = integralHistogram->bins + (rect.bottom * stride + rect.left) * binCount;
+    const double* bottomRight = integralHistogram->bins + (rect.bottom * stride + rect.right) * binCount;
+
+    for (int bin = 0; bin < binCount; ++bin)
+        histogram[bin] = bottomRight[bin] - bottomLeft[bin] - topRight[bin] + topLeft[bin];
+
+    return histogram;
+}
+
+size_t CalculateHOGDescriptorLength(const HOGParameters* parameters)
+{
+    assert(parameters != NULL);
+
+    const int blockCountX = parameters->windowSize.cx / parameters->cellSize.cx - parameters->blockSize.cx + 1;
+    const int blockCountY = parameters->windowSize.cy / parameters->cellSize.cy - parameters->blockSize.cy + 1;
+
+    return blockCountX * blockCountY * parameters->blockSize.cx * parameters->blockSize.cy * parameters->binCount;
+}
+
+SIZE CalculateHOGWindowGrid(const HOGParameters* parameters, SIZE imageSize, SIZE windowStride)
+{
+    assert(parameters != NULL);
+    assert(windowStride.cx > 0 && windowStride.cy > 0);
+
+    SIZE windowGrid = { 0, 0 };
+
+    if (parameters->windowSize.cx <= imageSize.cx && parameters->windowSize.cy <= imageSize.cy)
+    {
+        windowGrid.cx = (imageSize.cx - parameters->windowSize.cx) / windowStride.cx + 1;
+        windowGrid.cy = (imageSize.cy - parameters->windowSize.cy) / windowStride.cy + 1;
+    }
+
+    return windowGrid;
+}
+
+// Dense sliding-window HOG. Neighboring windows share most of their blocks, so the L2-Hys normalized block
+// descriptors are computed once on the lattice spanned by the window stride and the cell size, each from
+// O(bins) integral histogram lookups per cell, and every window only gathers its blocks from that lattice.
+// descriptors receives CalculateHOGWindowGrid windows in row-major order, CalculateHOGDescriptorLength floats
+// each.
+float* ExtractHOGDescriptors(const IntegralHistogram* integralHistogram, float* descriptors, const HOGParameters* parameters, SIZE windowStride)
+{
+    assert(integralHistogram != NULL);
+    assert(descriptors       != NULL);
+    assert(parameters        != NULL);
+    assert(parameters->binCount == integralHistogram->binCount);
+    assert(parameters->windowSize.cx % parameters->cellSize.cx == 0);
+    assert(parameters->windowSize.cy % parameters->cellSize.cy == 0);
+
+    const SIZE   imageSize        = integralHistogram->imageSize;
+    const SIZE   windowGrid       = CalculateHOGWindowGrid(parameters, imageSize, windowStride);
+    const SIZE   blockPixels      = { parameters->blockSize.cx * parameters->cellSize.cx, parameters->blockSize.cy * parameters->cellSize.cy };
+    const SIZE   latticeStep      = { static_cast<LONG>(CalculateGreatestCommonDivisor(windowStride.cx, parameters->cellSize.cx)), static_cast<LONG>(CalculateGreatestCommonDivisor(windowStride.cy, parameters->cellSize.cy)) };
+    const SIZE   latticeSize      = { (imageSize.cx - blockPixels.cx) / latticeStep.cx + 1, (imageSize.cy - blockPixels.cy) / latticeStep.cy + 1 };
+    const int    blockLength      = parameters->blockSize.cx * parameters->blockSize.cy * parameters->binCount;
+    const int    windowBlocksX    = parameters->windowSize.cx / parameters->cellSize.cx - parameters->blockSize.cx + 1;
+    const int    windowBlocksY    = parameters->windowSize.cy / parameters->cellSize.cy - parameters->blockSize.cy + 1;
+    const size_t descriptorLength = CalculateHOGDescriptorLength(parameters);
+
+    if (windowGrid.cx == 0 || windowGrid.cy == 0)
+        return descriptors;
+
+    float* blockDescriptors = new float[latticeSize.cx * latticeSize.cy * blockLength];
+
+    for (int by = 0; by < latticeSize.cy; ++by)
+        for (int bx = 0; bx < latticeSize.cx; ++bx)
+        {
+            float* block    = blockDescriptors + (by * latticeSize.cx + bx) * blockLength;
+            double cellHistogram[MAX_HOG_BIN_COUNT];
+            double normSum  = 0.0;
+
+            for (int cy = 0; cy < parameters->blockSize.cy; ++cy)
+                for (int cx = 0; cx < parameters->blockSize.cx; ++cx)
+                {
+                    RECT cellRect;
+
+                    cellRect.left   = bx * latticeStep.cx + cx * parameters->cellSize.cx;
+                    cellRect.top    = by * latticeStep.cy + cy * parameters->cellSize.cy;
+                    cellRect.right  = cellRect.left + parameters->cellSize.cx;
+                    cellRect.bottom = cellRect.top + parameters->cellSize.cy;
+
+                    CalculateRectHistogram(integralHistogram, cellRect, cellHistogram);
+
+                    for (int bin = 0; bin < parameters->binCount; ++bin)
+                        block[(cy * parameters->blockSize.cx + cx) * parameters->binCount + bin] = static_cast<float>(cellHistogram[bin]);
+                }
+
+            for (int index = 0; index < blockLength; ++index)
+                normSum += block[index] * block[index];
+
+            double norm = sqrt(normSum + 1e-3);
+
+            normSum = 0.0;
+
+            for (int index = 0; index < blockLength; ++index)
+            {
+                block[index] = std::min(static_cast<float>(block[index] / norm), 0.2f);
+                normSum     += block[index] * block[index];
+            }
+
+            norm = sqrt(normSum + 1e-3);
+
+            for (int index = 0; index < blockLength; ++index)
+                block[index] = static_cast<float>(block[index] / norm);
+        }
+
+    for (int wy = 0; wy < windowGrid.cy; ++wy)
+        for (int wx = 0; wx < windowGrid.cx; ++wx)
+        {
+            float* descriptor = descriptors + (wy * windowGrid.cx + wx) * descriptorLength;
+
+            for (int by = 0; by < windowBlocksY; ++by)
+                for (int bx = 0; bx < windowBlocksX; ++bx)
+                {
+                    int latticeX = (wx * windowStride.cx + bx * parameters->cellSize.cx) / latticeStep.cx;
+                    int latticeY = (wy * windowStride.cy + by * parameters->cellSize.cy) / latticeStep.cy;
+
+                    memcpy(descriptor + (by * windowBlocksX + bx) * blockLength, blockDescriptors + (latticeY * latticeSize.cx + latticeX) * blockLength, sizeof(float) * blockLength);
+                }
+        }
+
+    delete[] blockDescriptors;
+
+    return descriptors;
+}
+
+float* ExtractHOGDescriptors(const byte_t* inputImage, float* descriptors, SIZE imageSize, const HOGParameters* parameters, SIZE windowStride)
+{
+    assert(inputImage  != NULL);
+    assert(descriptors != NULL);
+    assert(parameters  != NULL);
+
+    mag_t* magnitudeX = new mag_t[imageSize.cx * imageSize.cy];
+    mag_t* magnitudeY = new mag_t[imageSize.cx * imageSize.cy];
+
+    Sobel(inputImage, magnitudeX, imageSize, SOBEL_X);
+    Sobel(inputImage, magnitudeY, imageSize, SOBEL_Y);
+
+    IntegralHistogram* integralHistogram = CreateIntegralHistogram(magnitudeX, magnitudeY, imageSize, parameters->binCount);
+
+    ExtractHOGDescriptors(integralHistogram, descriptors, parameters, windowStride);
+
+    ReleaseIntegralHistogram(integralHistogram);
+
+    delete[] magnitudeX;
+    delete[] magnitudeY;
+
+    return descriptors;
+}
+
+// +-----------------------------------------< INCREMENTAL SOBEL >------------------------------------------+
+
+SobelIncrementalCache* CreateSobelIncrementalCache(SIZE imageSize)
+{
+    const int  width     = imageSize.cx;
+    const int  height    = imageSize.cy;
+    const SIZE tileCount = CalculateTileCount(imageSize);
+
+    SobelIncrementalCache* cache = new SobelIncrementalCache;
+
+    cache->initialized     = false;
+    cache->imageSize       = imageSize;
+    cache->tileCount       = tileCount;
+    cache->previousImage   = new byte_t[width * height];
+    cache->magnitudeX      = new mag_t[width * height];
+    cache->magnitudeY      = new mag_t[width * height];
+    cache->sobelImage      = new mag_t[width * height];
+    cache->normalizedImage = new byte_t[width * height];
+    cache->edgeImage       = new byte_t[width * height];
+    cache->dirtyTiles      = new bool[tileCount.cx * tileCount.cy];
+    cache->updatedTiles    = new bool[tileCount.cx * tileCount.cy];
+    cache->tileMaxValue    = new mag_t[tileCount.cx * tileCount.cy];
+    cache->tileMinValue    = new mag_t[tileCount.cx * tileCount.cy];
+
+    memset(cache->sobelImage, 0, sizeof(mag_t) * width * height);
+    memset(cache->normalizedImage, 0, sizeof(byte_t) * width * height);
+    memset(cache->histogram, 0, sizeof(cache->histogram));
+
+    cache->histogram[0] = width * height;
+    cache->maxValue     = 0;
+    cache->minValue     = 0;
+    cache->threshold    = 0;
+
+    return cache;
+}
+
+void ReleaseSobelIncrementalCache(SobelIncrementalCache* cache)
+{
+    assert(cache != NULL);
+
+    delete[] cache->previousImage;
+    delete[] cache->magnitudeX;
+    delete[] cache->magnitudeY;
+    delete[] cache->sobelImage;
+    delete[] cache->normalizedImage;
+    delete[] cache->edgeImage;
+    delete[] cache->dirtyTiles;
+    delete[] cache->updatedTiles;
+    delete[] cache->tileMaxValue;
+    delete[] cache->tileMinValue;
+
+    delete cache;
+}
+
+void UpdateSobelTileExtrema(SobelIncrementalCache* cache, int tx, int ty)
+{
+    assert(cache != NULL);
+
+    const int width = cache->imageSize.cx;
+
+    RECT  tileRect = CalculateTileRect(tx, ty, { 0, 0 }, { 0, 0, cache->imageSize.cx, cache->imageSize.cy });
+    mag_t maxValue = cache->sobelImage[tileRect.top * width + tileRect.left];
+    mag_t minValue = maxValue;
+
+    for (int iy = tileRect.top; iy < tileRect.bottom; ++iy)
+        for (int ix = tileRect.left; ix < tileRect.right; ++ix)
+        {
+            maxValue = std::max(maxValue, cache->sobelImage[iy * width + ix]);
+            minValue = std::min(minValue, cache->sobelImage[iy * width + ix]);
+        }
+
+    cache->tileMaxValue[ty * cache->tileCount.cx + tx] = maxValue;
+    cache->tileMinValue[ty * cache->tileCount.cx + tx] = minValue;
+}
+
+void UpdateSobelNormalization(SobelIncrementalCache* cache, RECT region)
+{
+    assert(cache != NULL);
+
+    const int width = cache->imageSize.cx;
+
+    double maxValue = static_cast<double>(cache->maxValue);
+    double minValue = static_cast<double>(cache->minValue);
+
+    for (int iy = region.top; iy < region.bottom; ++iy)
+        for (int ix = region.left; ix < region.right; ++ix)
+        {
+            byte_t normalizedValue = NormalizeValue(cache->sobelImage[iy * width + ix], minValue, maxValue);
+
+            cache->histogram[cache->normalizedImage[iy * width + ix]]--;
+            cache->histogram[normalizedValue]++;
+
+            cache->normalizedImage[iy * width + ix] = normalizedValue;
+        }
+}
+
+void UpdateSobelThreshold(SobelIncrementalCache* cache, RECT region)
+{
+    assert(cache != NULL);
+
+    const int width = cache->imageSize.cx;
+
+    for (int iy = region.top; iy < region.bottom; ++iy)
+        for (int ix = region.left; ix < region.right; ++ix)
+            cache->edgeImage[iy * width + ix] = (cache->normalizedImage[iy * width + ix] >= cache->threshold) ? (0) : (255);
+}
+
+// Equivalent to SobelEdge followed by MaxEdgeRatioThreshold, but only the tiles that differ from the previous
+// frame (plus the one pixel Sobel halo) are recomputed. Per-tile extrema and the normalized histogram are kept
+// in the cache so the global minimum, maximum and threshold are updated without a full-frame pass; the whole
+// frame is only renormalized or rethresholded when one of them actually changes.
+byte_t* SobelEdgeIncremental(SobelIncrementalCache* cache, const byte_t* inputImage, byte_t* outputImage, const double edgeRatio)
+{
+    assert(cache       != NULL);
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    const SIZE   imageSize    = cache->imageSize;
+    const SIZE   tileCount    = cache->tileCount;
+    const size_t pixelCount   = static_cast<size_t>(imageSize.cx) * imageSize.cy;
+    const RECT   frameRect    = { 0, 0, imageSize.cx, imageSize.cy };
+    const RECT   interiorRect = { 1, 1, imageSize.cx - 1, imageSize.cy - 1 };
+    const SIZE   sobelHalo    = { 1, 1 };
+
+    bool*  dirtyTiles     = cache->dirtyTiles;
+    bool*  updatedTiles   = cache->updatedTiles;
+    bool   fullUpdate     = !cache->initialized;
+    size_t dirtyTileCount = tileCount.cx * tileCount.cy;
+
+    if (cache->initialized)
+        dirtyTileCount = FindDirtyTiles(cache->previousImage, inputImage, imageSize, dirtyTiles);
+    else
+        std::fill(dirtyTiles, dirtyTiles + tileCount.cx * tileCount.cy, true);
+
+    if (dirtyTileCount == 0 && CalculateMaxEdgeRatioThreshold(cache->histogram, pixelCount, edgeRatio) == cache->threshold)
+    {
+        memcpy(outputImage, cache->edgeImage, sizeof(byte_t) * pixelCount);
+
+        return outputImage;
+    }
+
+    std::fill(updatedTiles, updatedTiles + tileCount.cx * tileCount.cy, false);
+
+    for (int ty = 0; ty < tileCount.cy; ++ty)
+        for (int tx = 0; tx < tileCount.cx; ++tx)
+        {
+            if (!dirtyTiles[ty * tileCount.cx + tx])
+                continue;
+
+            RECT region = CalculateTileRect(tx, ty, sobelHalo, interiorRect);
+
+            ConvolveRegion(inputImage, cache->magnitudeX, imageSize, SelectSobelKernel(SOBEL_X, GetTuningProfile()->sobelVariant), region);
+            ConvolveRegion(inputImage, cache->magnitudeY, imageSize, SelectSobelKernel(SOBEL_Y, GetTuningProfile()->sobelVariant), region);
+
+            for (int iy = region.top; iy < region.bottom; ++iy)
+                for (int ix = region.left; ix < region.right; ++ix)
+                    cache->sobelImage[iy * imageSize.cx + ix] = abs(cache->magnitudeX[iy * imageSize.cx + ix]) + abs(cache->magnitudeY[iy * imageSize.cx + ix]);
+
+            for (int uy = std::max(ty - 1, 0); uy <= std::min<int>(ty + 1, tileCount.cy - 1); ++uy)
+                for (int ux = std::max(tx - 1, 0); ux <= std::min<int>(tx + 1, tileCount.cx - 1); ++ux)
+                    updatedTiles[uy * tileCount.cx + ux] = true;
+
+            CopyTile(inputImage, cache->previousImage, imageSize, tx, ty);
+        }
+
+    for (int ty = 0; ty < tileCount.cy; ++ty)
+        for (int tx = 0; tx < tileCount.cx; ++tx)
+            if (updatedTiles[ty * tileCount.cx + tx])
+                UpdateSobelTileExtrema(cache, tx, ty);
+
+    mag_t maxValue = *std::max_element(cache->tileMaxValue, cache->tileMaxValue + tileCount.cx * tileCount.cy);
+    mag_t minValue = *std::min_element(cache->tileMinValue, cache->tileMinValue + tileCount.cx * tileCount.cy);
+
+    if (maxValue != cache->maxValue || minValue != cache->minValue)
+        fullUpdate = true;
+
+    cache->maxValue = maxValue;
+    cache->minValue = minValue;
+
+    if (fullUpdate)
+        UpdateSobelNormalization(cache, frameRect);
+    else
+        for (int ty = 0; ty < tileCount.cy; ++ty)
+            for (int tx = 0; tx < tileCount.cx; ++tx)
+                if (dirtyTiles[ty * tileCount.cx + tx])
+                    UpdateSobelNormalization(cache, CalculateTileRect(tx, ty, sobelHalo, interiorRect));
+
+    int threshold = CalculateMaxEdgeRatioThreshold(cache->histogram, pixelCount, edgeRatio);
+
+    if (threshold != cache->threshold)
+        fullUpdate = true;
+
+    cache->threshold = threshold;
+
+    if (fullUpdate)
+        UpdateSobelThreshold(cache, frameRect);
+    else
+        for (int ty = 0; ty < tileCount.cy; ++ty)
+            for (int tx = 0; tx < tileCount.cx; ++tx)
+                if (dirtyTiles[ty * tileCount.cx + tx])
+                    UpdateSobelThreshold(cache, CalculateTileRect(tx, ty, sobelHalo, interiorRect));
+
+    cache->initialized = true;
+
+    memcpy(outputImage, cache->edgeImage, sizeof(byte_t) * pixelCount);
+
+    return outputImage;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,90 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Convolution.h"
+#include "Pyramid.h"
+
+#include <cstddef>
+
+// +-----------------------------------------------< SOBEL >------------------------------------------------+
+
+extern const ConvolutionKernel SOBEL_KERNEL_X;
+extern const ConvolutionKernel SOBEL_KERNEL_Y;
+
+const ConvolutionKernel* SelectSobelKernel(const int direction, const int variant);
+mag_t*                   Sobel(const byte_t* inputImage, mag_t* sobelImage, SIZE imageSize, const int direction);
+mag_t*                   Sobel(const ImageSource* source, mag_t* sobelImage, const int direction);
+byte_t*                  SobelEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize);
+byte_t*                  SobelEdge(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const bool* tileMask);
+byte_t*                  SobelEdge(const ImageSource* source, byte_t* outputImage);
+byte_t*                  GradientMagnitudeEdge(const mag_t* magnitudeX, const mag_t* magnitudeY, byte_t* outputImage, SIZE imageSize);
+ScaleSpaceMap*           SobelEdgePyramid(ImagePyramid* pyramid);
+
+// +----------------------------------< HISTOGRAM OF ORIENTED GRADIENTS >-----------------------------------+
+
+static const int MAX_HOG_BIN_COUNT = 36;
+
+// One summed-area table per orientation bin, stored bin-interleaved: the binCount sums of corner (x, y) are
+// contiguous at bins[(y * (imageSize.cx + 1) + x) * binCount], so the histogram of any rectangle is four
+// contiguous reads per bin.
+struct IntegralHistogram
+{
+    SIZE    imageSize;
+    int     binCount;
+    double* bins;
+};
+
+struct HOGParameters
+{
+    SIZE windowSize;
+    SIZE cellSize;
+    SIZE blockSize;
+    int  binCount;
+};
+
+static const HOGParameters DEFAULT_HOG_PARAMETERS = { { 64, 128 }, { 8, 8 }, { 2, 2 }, 9 };
+
+IntegralHistogram* CreateIntegralHistogram(const mag_t* magnitudeX, const mag_t* magnitudeY, SIZE imageSize, const int binCount);
+void               ReleaseIntegralHistogram(IntegralHistogram* histogram);
+double*            CalculateRectHistogram(const IntegralHistogram* integralHistogram, RECT rect, double* histogram);
+
+size_t             CalculateHOGDescriptorLength(const HOGParameters* parameters);
+SIZE               CalculateHOGWindowGrid(const HOGParameters* parameters, SIZE imageSize, SIZE windowStride);
+float*             ExtractHOGDescriptors(const IntegralHistogram* integralHistogram, float* descriptors, const HOGParameters* parameters, SIZE windowStride);
+float*             ExtractHOGDescriptors(const byte_t* inputImage, float* descriptors, SIZE imageSize, const HOGParameters* parameters, SIZE windowStride);
+
+// +-----------------------------------------< INCREMENTAL SOBEL >------------------------------------------+
+
+struct SobelIncrementalCache
+{
+    bool     initialized;
+    SIZE     imageSize;
+    SIZE     tileCount;
+
+    byte_t*  previousImage;
+    mag_t*   magnitudeX;
+    mag_t*   magnitudeY;
+    mag_t*   sobelImage;
+    byte_t*  normalizedImage;
+    byte_t*  edgeImage;
+
+    bool*    dirtyTiles;
+    bool*    updatedTiles;
+    mag_t*   tileMaxValue;
+    mag_t*   tileMinValue;
+    mag_t    maxValue;
+    mag_t    minValue;
+
+    uint32_t histogram[256];
+    int      threshold;
+};
+
+SobelIncrementalCache* CreateSobelIncrementalCache(SIZE imageSize);
+void                   ReleaseSobelIncrementalCache(SobelIncrementalCache* cache);
+byte_t*                SobelEdgeIncremental(SobelIncrementalCache* cache, const byte_t* inputImage, byte_t* outputImage, const double edgeRatio = 0.2);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,353 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Structuring Element.h"
+#include "Autotune.h"
+
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cmath>
+#include <cstring>
+
+// +----------------------------------------< STRUCTURING ELEMENT >-----------------------------------------+
+
+SIZE CalculateLineExtent(LineSegment line)
+{
+    assert(line.length % 2 == 1);
+
+    const double dx   = fabs(cos(line.angle * PI / 180.0));
+    const double dy   = fabs(sin(line.angle * PI / 180.0));
+    const double run  = std::min(dx, dy) / std::max(dx, dy);
+    const int    half = line.length / 2;
+
+    int crossExtent = static_cast<int>(floor(half * run)) + 1;
+
+    if (run < 1e-9)
+        crossExtent = 0;
+    else if (run > 1.0 - 1e-9)
+        crossExtent = half;
+
+    SIZE extent = { half, crossExtent };
+
+    if (dx < dy)
+        std::swap(extent.cx, extent.cy);
+
+    return extent;
+}
+
+StructuringElement* AppendStructuringElementPass(StructuringElement* element, LineSegment firstLine, LineSegment secondLine)
+{
+    assert(element != NULL);
+    assert(element->passCount < MAX_PASS_COUNT);
+    assert(firstLine.length % 2 == 1 && secondLine.length % 2 == 1);
+
+    if (firstLine.length == 1 && secondLine.length == 1)
+        return element;
+
+    StructuringElementPass& pass = element->passes[element->passCount++];
+    SIZE firstExtent             = CalculateLineExtent(firstLine);
+    SIZE secondExtent            = CalculateLineExtent(secondLine);
+
+    pass.lineCount = 0;
+    pass.lines[pass.lineCount++] = firstLine;
+
+    if (secondLine.length > 1)
+        pass.lines[pass.lineCount++] = secondLine;
+
+    element->extent.cx += std::max(firstExtent.cx, secondExtent.cx);
+    element->extent.cy += std::max(firstExtent.cy, secondExtent.cy);
+
+    return element;
+}
+
+StructuringElement CreateRectangleElement(SIZE wsize)
+{
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    StructuringElement element = {};
+
+    AppendStructuringElementPass(&element, { 0.0, static_cast<int>(wsize.cx) });
+    AppendStructuringElementPass(&element, { 90.0, static_cast<int>(wsize.cy) });
+
+    return element;
+}
+
+StructuringElement CreateLineElement(const int length, const double angle)
+{
+    assert(length % 2 == 1);
+
+    StructuringElement element = {};
+
+    AppendStructuringElementPass(&element, { angle, length });
+
+    return element;
+}
+
+StructuringElement CreateCrossElement(const int length)
+{
+    assert(length % 2 == 1);
+
+    StructuringElement element = {};
+
+    AppendStructuringElementPass(&element, { 0.0, length }, { 90.0, length });
+
+    return element;
+}
+
+// Diamond of odd radius 2m + 1 = diagonal(2m + 1) + anti-diagonal(2m + 1) + cross(3); the two diagonal lines
+// cover the lattice points of one parity and the cross fills in the other. Even radii add one more cross.
+StructuringElement CreateDiamondElement(const int radius)
+{
+    assert(radius >= 0);
+
+    StructuringElement element = {};
+
+    if (radius == 0)
+        return element;
+
+    const int oddRadius = (radius % 2 == 1) ? (radius) : (radius - 1);
+
+    AppendStructuringElementPass(&element, { 45.0, oddRadius });
+    AppendStructuringElementPass(&element, { 135.0, oddRadius });
+    AppendStructuringElementPass(&element, { 0.0, 3 }, { 90.0, 3 });
+
+    if (radius % 2 == 0)
+        AppendStructuringElementPass(&element, { 0.0, 3 }, { 90.0, 3 });
+
+    return element;
+}
+
+// Disk approximated by an octagon: square(2a + 1) + diagonal(2b + 1) + anti-diagonal(2b + 1), with a and b
+// chosen so that both the axis extent a + 2b and the diagonal extent (a + b) * sqrt(2) are close to the radius.
+// Radii up to 2 are exactly diamonds.
+StructuringElement CreateDiskElement(const int radius)
+{
+    assert(radius >= 0);
+
+    if (radius <= 2)
+        return CreateDiamondElement(radius);
+
+    StructuringElement element = {};
+
+    const int diagonalHalf = static_cast<int>(floor(radius * (1.0 - 1.0 / sqrt(2.0)) + 0.5));
+    const int axisHalf     = radius - 2 * diagonalHalf;
+
+    AppendStructuringElementPass(&element, { 0.0, 2 * axisHalf + 1 });
+    AppendStructuringElementPass(&element, { 90.0, 2 * axisHalf + 1 });
+    AppendStructuringElementPass(&element, { 45.0, 2 * diagonalHalf + 1 });
+    AppendStructuringElementPass(&element, { 135.0, 2 * diagonalHalf + 1 });
+
+    return element;
+}
+
+// result[i] = max(values[i], ..., values[i + length - 1]) with three comparisons per element.
+void CalculateRunningMax(const byte_t* values, byte_t* result, byte_t* prefix, byte_t* suffix, const int count, const int length)
+{
+    assert(values != NULL && result != NULL);
+    assert(prefix != NULL && suffix != NULL);
+
+    const int paddedCount = count + length - 1;
+
+    for (int block = 0; block < paddedCount; block += length)
+    {
+        const int blockEnd = std::min(block + length, paddedCount);
+
+        prefix[block] = values[block];
+        for (int index = block + 1; index < blockEnd; ++index)
+            prefix[index] = std::max(prefix[index - 1], values[index]);
+
+        suffix[blockEnd - 1] = values[blockEnd - 1];
+        for (int index = blockEnd - 2; index >= block; --index)
+            suffix[index] = std::max(suffix[index + 1], values[index]);
+    }
+
+    for (int index = 0; index < count; ++index)
+        result[index] = std::max(suffix[index], prefix[index + length - 1]);
+}
+
+byte_t* CalculateLineMax(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, LineSegment line)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(line.length % 2 == 1);
+
+    const int    width         = imageSize.cx;
+    const int    height        = imageSize.cy;
+    const double dx            = cos(line.angle * PI / 180.0);
+    const double dy            = -sin(line.angle * PI / 180.0);
+    const bool   majorX        = fabs(dx) >= fabs(dy);
+    const int    pathLength    = majorX ? width : height;
+    const int    crossSize     = majorX ? height : width;
+    const int    primaryStride = majorX ? 1 : width;
+    const int    crossStride   = majorX ? width : 1;
+    const int    half          = line.length / 2;
+
+    double slope = majorX ? dy / dx : dx / dy;
+
+    if (fabs(slope - floor(slope + 0.5)) < 1e-9)
+        slope = floor(slope + 0.5);
+
+    int*    shifts   = new int[pathLength];
+    byte_t* values   = new byte_t[pathLength + line.length - 1];
+    byte_t* prefix   = new byte_t[pathLength + line.length - 1];
+    byte_t* suffix   = new byte_t[pathLength + line.length - 1];
+    byte_t* result   = new byte_t[pathLength];
+    int     minShift = 0;
+    int     maxShift = 0;
+
+    for (int index = 0; index < pathLength; ++index)
+    {
+        shifts[index] = static_cast<int>(floor(index * slope + 0.5));
+        minShift      = std::min(minShift, shifts[index]);
+        maxShift      = std::max(maxShift, shifts[index]);
+    }
+
+    memset(values, 0, sizeof(byte_t) * (pathLength + line.length - 1));
+
+    for (int offset = -maxShift; offset < crossSize - minShift; ++offset)
+    {
+        for (int index = 0; index < pathLength; ++index)
+        {
+            int cross = offset + shifts[index];
+
+            values[half + index] = (cross >= 0 && cross < crossSize) ? (inputImage[index * primaryStride + cross * crossStride]) : (0);
+        }
+
+        CalculateRunningMax(values, result, prefix, suffix, pathLength, line.length);
+
+        for (int index = 0; index < pathLength; ++index)
+        {
+            int cross = offset + shifts[index];
+
+            if (cross >= 0 && cross < crossSize)
+                outputImage[index * primaryStride + cross * crossStride] = result[index];
+        }
+    }
+
+    delete[] shifts;
+    delete[] values;
+    delete[] prefix;
+    delete[] suffix;
+    delete[] result;
+
+    return outputImage;
+}
+
+// Runs the passes of the element in place on image.
+static void RunElementPasses(byte_t* image, SIZE imageSize, const StructuringElement* element)
+{
+    const int pixelCount = imageSize.cx * imageSize.cy;
+
+    byte_t* passImage = new byte_t[pixelCount];
+    byte_t* lineImage = new byte_t[pixelCount];
+
+    for (int pass = 0; pass < element->passCount; ++pass)
+    {
+        memcpy(passImage, image, sizeof(byte_t) * pixelCount);
+
+        CalculateLineMax(passImage, image, imageSize, element->passes[pass].lines[0]);
+
+        for (int line = 1; line < element->passes[pass].lineCount; ++line)
+        {
+            CalculateLineMax(passImage, lineImage, imageSize, element->passes[pass].lines[line]);
+
+            for (int index = 0; index < pixelCount; ++index)
+                image[index] = std::max(image[index], lineImage[index]);
+        }
+    }
+
+    delete[] passImage;
+    delete[] lineImage;
+}
+
+// Each pass clips its lines to the image, so chained passes only reach the element points whose intermediate
+// points lie inside the image too. Chains of axis-aligned lines reach the same points either way; any other
+// chain needs the passes to run on an image padded by the element extent.
+static bool IsPaddingRequired(const StructuringElement* element)
+{
+    if (element->passCount <= 1)
+        return false;
+
+    for (int pass = 0; pass < element->passCount; ++pass)
+    {
+        const double angle = fmod(fabs(element->passes[pass].lines[0].angle), 90.0);
+
+        if (element->passes[pass].lineCount > 1 || (angle > 1e-9 && angle < 90.0 - 1e-9))
+            return true;
+    }
+
+    return false;
+}
+
+// Grey-level dilation by the structuring element; pixels within element.extent of the border are only
+// partially covered by the element and hold the maximum over its part inside the image. Elements whose passes
+// do not compose exactly under clipping run on an image padded with zeros, which never raise a maximum.
+byte_t* CalculateElementMax(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    if (!IsPaddingRequired(element))
+    {
+        memcpy(outputImage, inputImage, sizeof(byte_t) * width * height);
+
+        RunElementPasses(outputImage, imageSize, element);
+
+        return outputImage;
+    }
+
+    const SIZE extent      = element->extent;
+    const SIZE paddedSize  = { width + 2 * extent.cx, height + 2 * extent.cy };
+    byte_t*    paddedImage = new byte_t[paddedSize.cx * paddedSize.cy];
+
+    memset(paddedImage, 0, sizeof(byte_t) * paddedSize.cx * paddedSize.cy);
+
+    for (int iy = 0; iy < height; ++iy)
+        memcpy(paddedImage + (iy + extent.cy) * paddedSize.cx + extent.cx, inputImage + iy * width, sizeof(byte_t) * width);
+
+    RunElementPasses(paddedImage, paddedSize, element);
+
+    for (int iy = 0; iy < height; ++iy)
+        memcpy(outputImage + iy * width, paddedImage + (iy + extent.cy) * paddedSize.cx + extent.cx, sizeof(byte_t) * width);
+
+    delete[] paddedImage;
+
+    return outputImage;
+}
+
+byte_t* CalculateElementMin(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(element     != NULL);
+
+    const int pixelCount = imageSize.cx * imageSize.cy;
+
+    byte_t* invertedImage = new byte_t[pixelCount];
+
+    for (int index = 0; index < pixelCount; ++index)
+        invertedImage[index] = UCHAR_MAX - inputImage[index];
+
+    CalculateElementMax(invertedImage, outputImage, imageSize, element);
+
+    for (int index = 0; index < pixelCount; ++index)
+        outputImage[index] = UCHAR_MAX - outputImage[index];
+
+    delete[] invertedImage;
+
+    return outputImage;
+}
+
+// Whether a rectangular wsize window operator should run as a rectangle element (van Herk / Gil-Werman)
+// instead of scanning every window, according to the tuning profile. Both give identical results.
+bool IsRunningWindowSelected(SIZE imageSize, SIZE wsize)
+{
+    return SelectWindowVariant(wsize) == WINDOW_VARIANT_RUNNING && wsize.cx / 2 < imageSize.cx / 2 && wsize.cy / 2 < imageSize.cy / 2;
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
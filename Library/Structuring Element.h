@@ -0,0 +1,52 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+
+// +----------------------------------------< STRUCTURING ELEMENT >-----------------------------------------+
+
+static const int MAX_PASS_LINE_COUNT = 2;
+static const int MAX_PASS_COUNT      = 8;
+
+struct LineSegment
+{
+    double angle;
+    int    length;
+};
+
+struct StructuringElementPass
+{
+    int         lineCount;
+    LineSegment lines[MAX_PASS_LINE_COUNT];
+};
+
+// A structuring element is stored as its decomposition: the shape is the Minkowski sum of the passes, and
+// each pass is the union of at most two centered discrete lines. Every line is evaluated with the van Herk /
+// Gil-Werman running extremum along Bresenham paths, so a pass costs a constant number of comparisons per
+// pixel regardless of its length. extent is the half size of the bounding box of the whole element.
+struct StructuringElement
+{
+    int                    passCount;
+    StructuringElementPass passes[MAX_PASS_COUNT];
+    SIZE                   extent;
+};
+
+SIZE                CalculateLineExtent(LineSegment line);
+StructuringElement* AppendStructuringElementPass(StructuringElement* element, LineSegment firstLine, LineSegment secondLine = { 0.0, 1 });
+
+StructuringElement  CreateRectangleElement(SIZE wsize);
+StructuringElement  CreateLineElement(const int length, const double angle);
+StructuringElement  CreateCrossElement(const int length);
+StructuringElement  CreateDiamondElement(const int radius);
+StructuringElement  CreateDiskElement(const int radius);
+
+byte_t*             CalculateLineMax(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, LineSegment line);
+byte_t*             CalculateElementMax(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+byte_t*             CalculateElementMin(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const StructuringElement* element);
+
+bool                IsRunningWindowSelected(SIZE imageSize, SIZE wsize);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
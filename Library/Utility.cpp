@@ -0,0 +1,313 @@
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Utility.h"
+
+#include <climits>
+#include <cstring>
+
+// +----------------------------------------------< UTILITY >-----------------------------------------------+
+
+// Pixels at or above the threshold are edges. It is 256, so that no pixel is, when the brightest bin alone
+// exceeds the ratio.
+int CalculateMaxEdgeRatioThreshold(const uint32_t* histogram, const size_t pixelCount, const double edgeRatio)
+{
+    assert(histogram != NULL);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    uint32_t histogramCount = 0;
+    int      threshold      = 0;
+
+    for (int brightness = 255; brightness >= 0; --brightness)
+        if ((histogramCount += histogram[brightness]) > pixelCount * edgeRatio)
+        {
+            threshold = brightness + 1;
+            break;
+        }
+
+    return threshold;
+}
+
+// Pixels at or below the threshold are edges. It is -1, so that no pixel is, when the darkest bin alone
+// exceeds the ratio.
+int CalculateMinEdgeRatioThreshold(const uint32_t* histogram, const size_t pixelCount, const double edgeRatio)
+{
+    assert(histogram != NULL);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    uint32_t histogramCount = 0;
+    int      threshold      = 255;
+
+    for (int brightness = 0; brightness < 256; ++brightness)
+        if ((histogramCount += histogram[brightness]) > pixelCount * edgeRatio)
+        {
+            threshold = brightness - 1;
+            break;
+        }
+
+    return threshold;
+}
+
+byte_t* MaxEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const double edgeRatio, DensityIndex* densityIndex)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    uint32_t histogram[256];
+    int      threshold = 0;
+
+    CalculateHistogram(inputImage, static_cast<size_t>(width) * height, histogram);
+
+    threshold = CalculateMaxEdgeRatioThreshold(histogram, static_cast<size_t>(width) * height, edgeRatio);
+
+    if (densityIndex != NULL)
+        ResetDensityIndex(densityIndex, imageSize);
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        for (int ix = 0; ix < width; ++ix)
+            outputImage[iy * width + ix] = (inputImage[iy * width + ix] >= threshold) ? (0) : (255);
+
+        if (densityIndex != NULL)
+            AccumulateDensityRow(densityIndex, outputImage + iy * width, iy, 0);
+    }
+
+    if (densityIndex != NULL)
+        FinishDensityIndex(densityIndex);
+
+    return outputImage;
+}
+
+byte_t* MinEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const double edgeRatio, DensityIndex* densityIndex)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+    assert(edgeRatio > 0.0 && edgeRatio <= 1.0);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    uint32_t histogram[256];
+    int      threshold = 255;
+
+    CalculateHistogram(inputImage, static_cast<size_t>(width) * height, histogram);
+
+    threshold = CalculateMinEdgeRatioThreshold(histogram, static_cast<size_t>(width) * height, edgeRatio);
+
+    if (densityIndex != NULL)
+        ResetDensityIndex(densityIndex, imageSize);
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        for (int ix = 0; ix < width; ++ix)
+            outputImage[iy * width + ix] = (inputImage[iy * width + ix] <= threshold) ? (0) : (255);
+
+        if (densityIndex != NULL)
+            AccumulateDensityRow(densityIndex, outputImage + iy * width, iy, 0);
+    }
+
+    if (densityIndex != NULL)
+        FinishDensityIndex(densityIndex);
+
+    return outputImage;
+}
+
+byte_t CalculateWindowMax(const byte_t* image, SIZE imageSize, POINT center, SIZE wsize)
+{
+    assert(image != NULL);
+    assert(center.x >= wsize.cx / 2 && center.x < imageSize.cx - wsize.cx / 2);
+    assert(center.y >= wsize.cy / 2 && center.y < imageSize.cy - wsize.cy / 2);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int width = imageSize.cx;
+
+    byte_t maxValue = 0;
+
+    for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+        for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+            if (image[(center.y + wy) * width + (center.x + wx)] > maxValue)
+                maxValue = image[(center.y + wy) * width + (center.x + wx)];
+
+    return maxValue;
+}
+
+byte_t CalculateWindowMin(const byte_t* image, SIZE imageSize, POINT center, SIZE wsize)
+{
+    assert(image != NULL);
+    assert(center.x >= wsize.cx / 2 && center.x < imageSize.cx - wsize.cx / 2);
+    assert(center.y >= wsize.cy / 2 && center.y < imageSize.cy - wsize.cy / 2);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int width = imageSize.cx;
+
+    byte_t minValue = UCHAR_MAX;
+
+    for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+        for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+            if (image[(center.y + wy) * width + (center.x + wx)] < minValue)
+                minValue = image[(center.y + wy) * width + (center.x + wx)];
+
+    return minValue;
+}
+
+// Both extremes of the window in a single sweep.
+void CalculateWindowMinMax(const byte_t* image, SIZE imageSize, POINT center, SIZE wsize, byte_t* minValue, byte_t* maxValue)
+{
+    assert(image    != NULL);
+    assert(minValue != NULL);
+    assert(maxValue != NULL);
+    assert(center.x >= wsize.cx / 2 && center.x < imageSize.cx - wsize.cx / 2);
+    assert(center.y >= wsize.cy / 2 && center.y < imageSize.cy - wsize.cy / 2);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int width = imageSize.cx;
+
+    *minValue = UCHAR_MAX;
+    *maxValue = 0;
+
+    for (int wy = -wsize.cy / 2; wy <= wsize.cy / 2; ++wy)
+        for (int wx = -wsize.cx / 2; wx <= wsize.cx / 2; ++wx)
+        {
+            const byte_t value = image[(center.y + wy) * width + (center.x + wx)];
+
+            *minValue = std::min(*minValue, value);
+            *maxValue = std::max(*maxValue, value);
+        }
+}
+
+// +-------------------------------------------< INTEGRAL IMAGE >-------------------------------------------+
+
+// The integral image of a camera frame without a packed gray copy: each source row is read in place or
+// converted to luma right before its row prefix sum, which is then added to the row above.
+lbyte_t* CreateIntegralImage(const ImageSource* source, lbyte_t* integralImage)
+{
+    assert(source        != NULL);
+    assert(integralImage != NULL);
+
+    const int width  = source->imageSize.cx;
+    const int height = source->imageSize.cy;
+
+    SourceRowReader* reader = CreateSourceRowReader(source, 1);
+
+    for (int iy = 0; iy < height; ++iy)
+    {
+        const byte_t* row         = ReadSourceRow(reader, iy);
+        lbyte_t*      integralRow = integralImage + iy * width;
+        lbyte_t       rowSum      = 0;
+
+        for (int ix = 0; ix < width; ++ix)
+            integralRow[ix] = (rowSum += row[ix]);
+
+        if (iy > 0)
+            for (int ix = 0; ix < width; ++ix)
+                integralRow[ix] += integralRow[ix - width];
+    }
+
+    ReleaseSourceRowReader(reader);
+
+    return integralImage;
+}
+
+// The window sum is taken modulo 2^32 like the integral image itself, so it is exact whenever the window sum
+// fits in 32 bits, even on images large enough for the integral image to wrap.
+lbyte_t CalculateIntegralWindowSum(const lbyte_t* integralImage, SIZE imageSize, POINT center, SIZE wsize)
+{
+    assert(integralImage != NULL);
+    assert(center.x >= wsize.cx / 2 && center.x < imageSize.cx - wsize.cx / 2);
+    assert(center.y >= wsize.cy / 2 && center.y < imageSize.cy - wsize.cy / 2);
+    assert(wsize.cx % 2 == 1);
+    assert(wsize.cy % 2 == 1);
+
+    const int width = imageSize.cx;
+
+    lbyte_t integralSum = integralImage[(center.y + wsize.cy / 2) * width + (center.x + wsize.cx / 2)];
+
+    if (center.x > wsize.cx / 2)
+        integralSum -= integralImage[(center.y + wsize.cy / 2) * width + (center.x - wsize.cx / 2 - 1)];
+    if (center.y > wsize.cy / 2)
+        integralSum -= integralImage[(center.y - wsize.cy / 2 - 1) * width + (center.x + wsize.cx / 2)];
+    if (center.x > wsize.cx / 2 && center.y > wsize.cy / 2)
+        integralSum += integralImage[(center.y - wsize.cy / 2 - 1) * width + (center.x - wsize.cx / 2 - 1)];
+
+    return integralSum;
+}
+
+// Signed average of a window whose sum fits in 31 bits, as the 32-bit Harris code computed it.
+double CalculateIntegralWindowAverage(const lbyte_t* integralImage, SIZE imageSize, POINT center, SIZE wsize)
+{
+    return static_cast<int32_t>(CalculateIntegralWindowSum(integralImage, imageSize, center, wsize)) / static_cast<int32_t>(wsize.cx * wsize.cy);
+}
+
+// +--------------------------------------------< TILE UTILITY >--------------------------------------------+
+
+SIZE CalculateTileCount(SIZE imageSize)
+{
+    SIZE tileCount = { (imageSize.cx + TILE_SIZE - 1) / TILE_SIZE, (imageSize.cy + TILE_SIZE - 1) / TILE_SIZE };
+
+    return tileCount;
+}
+
+RECT CalculateTileRect(int tx, int ty, SIZE halo, RECT bounds)
+{
+    assert(tx >= 0 && ty >= 0);
+    assert(halo.cx >= 0 && halo.cy >= 0);
+
+    RECT tileRect;
+
+    tileRect.left   = std::max<LONG>(tx * TILE_SIZE - halo.cx, bounds.left);
+    tileRect.top    = std::max<LONG>(ty * TILE_SIZE - halo.cy, bounds.top);
+    tileRect.right  = std::min<LONG>((tx + 1) * TILE_SIZE + halo.cx, bounds.right);
+    tileRect.bottom = std::min<LONG>((ty + 1) * TILE_SIZE + halo.cy, bounds.bottom);
+
+    return tileRect;
+}
+
+size_t FindDirtyTiles(const byte_t* previousImage, const byte_t* currentImage, SIZE imageSize, bool* dirtyTiles)
+{
+    assert(previousImage != NULL);
+    assert(currentImage  != NULL);
+    assert(dirtyTiles    != NULL);
+
+    const int  width     = imageSize.cx;
+    const SIZE tileCount = CalculateTileCount(imageSize);
+
+    size_t dirtyTileCount = 0;
+
+    for (int ty = 0; ty < tileCount.cy; ++ty)
+        for (int tx = 0; tx < tileCount.cx; ++tx)
+        {
+            RECT tileRect = CalculateTileRect(tx, ty, { 0, 0 }, { 0, 0, imageSize.cx, imageSize.cy });
+            bool dirty    = false;
+
+            for (int iy = tileRect.top; iy < tileRect.bottom && !dirty; ++iy)
+                dirty = memcmp(previousImage + iy * width + tileRect.left, currentImage + iy * width + tileRect.left, tileRect.right - tileRect.left) != 0;
+
+            if (dirty)
+                dirtyTileCount++;
+
+            dirtyTiles[ty * tileCount.cx + tx] = dirty;
+        }
+
+    return dirtyTileCount;
+}
+
+void CopyTile(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, int tx, int ty)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const int width = imageSize.cx;
+
+    RECT tileRect = CalculateTileRect(tx, ty, { 0, 0 }, { 0, 0, imageSize.cx, imageSize.cy });
+
+    for (int iy = tileRect.top; iy < tileRect.bottom; ++iy)
+        memcpy(outputImage + iy * width + tileRect.left, inputImage + iy * width + tileRect.left, sizeof(byte_t) * (tileRect.right - tileRect.left));
+}
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file
@@ -0,0 +1,98 @@
+// +-------------------------------------------< PREPROCESSING >--------------------------------------------+
+
+#pragma once
+
+// +----------------------------------------------< INCLUDE >-----------------------------------------------+
+
+#include "Common.h"
+#include "Density Index.h"
+#include "Image Source.h"
+#include "Reduction.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+
+// +----------------------------------------------< UTILITY >-----------------------------------------------+
+
+// Maps value from [minValue, maxValue] to [0, 255]; a constant image, where the range is empty, maps to 0.
+inline byte_t NormalizeValue(const double value, const double minValue, const double maxValue)
+{
+    return (maxValue > minValue) ? (static_cast<byte_t>(255 * (value - minValue) / (maxValue - minValue))) : (0);
+}
+
+template <typename value_t>
+byte_t* Normalization(const value_t* inputImage, byte_t* outputImage, SIZE imageSize)
+{
+    assert(inputImage  != NULL);
+    assert(outputImage != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    value_t minElement;
+    value_t maxElement;
+
+    ReduceMinMax(inputImage, static_cast<size_t>(width) * height, &minElement, &maxElement);
+
+    double maxValue = static_cast<double>(maxElement);
+    double minValue = static_cast<double>(minElement);
+
+    for (int iy = 0; iy < height; ++iy)
+        for (int ix = 0; ix < width; ++ix)
+            outputImage[iy * width + ix] = NormalizeValue(inputImage[iy * width + ix], minValue, maxValue);
+
+    return outputImage;
+}
+
+int     CalculateMaxEdgeRatioThreshold(const uint32_t* histogram, const size_t pixelCount, const double edgeRatio = 0.2);
+int     CalculateMinEdgeRatioThreshold(const uint32_t* histogram, const size_t pixelCount, const double edgeRatio = 0.2);
+byte_t* MaxEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const double edgeRatio = 0.2, DensityIndex* densityIndex = NULL);
+byte_t* MinEdgeRatioThreshold(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, const double edgeRatio = 0.2, DensityIndex* densityIndex = NULL);
+
+byte_t  CalculateWindowMax(const byte_t* image, SIZE imageSize, POINT center, SIZE wsize);
+byte_t  CalculateWindowMin(const byte_t* image, SIZE imageSize, POINT center, SIZE wsize);
+void    CalculateWindowMinMax(const byte_t* image, SIZE imageSize, POINT center, SIZE wsize, byte_t* minValue, byte_t* maxValue);
+
+// +-------------------------------------------< INTEGRAL IMAGE >-------------------------------------------+
+
+template <typename value_t>
+lbyte_t* CreateIntegralImage(const value_t* inputImage, lbyte_t* integralImage, SIZE imageSize)
+{
+    assert(inputImage    != NULL);
+    assert(integralImage != NULL);
+
+    const int width  = imageSize.cx;
+    const int height = imageSize.cy;
+
+    for (int iy = 0; iy < height; ++iy)
+        integralImage[iy * width] = inputImage[iy * width];
+
+    for (int iy = 0; iy < height; ++iy)
+        for (int ix = 1; ix < width; ++ix)
+            integralImage[iy * width + ix] = inputImage[iy * width + ix] + integralImage[iy * width + (ix - 1)];
+
+    // Column sums are accumulated a row at a time, so both rows are read contiguously instead of striding down
+    // each column.
+    for (int iy = 1; iy < height; ++iy)
+        for (int ix = 0; ix < width; ++ix)
+            integralImage[iy * width + ix] += integralImage[(iy - 1) * width + ix];
+
+    return integralImage;
+}
+
+lbyte_t* CreateIntegralImage(const ImageSource* source, lbyte_t* integralImage);
+
+lbyte_t CalculateIntegralWindowSum(const lbyte_t* integralImage, SIZE imageSize, POINT center, SIZE wsize);
+double  CalculateIntegralWindowAverage(const lbyte_t* integralImage, SIZE imageSize, POINT center, SIZE wsize);
+
+// +--------------------------------------------< TILE UTILITY >--------------------------------------------+
+
+static const int TILE_SIZE = 32;
+
+SIZE   CalculateTileCount(SIZE imageSize);
+RECT   CalculateTileRect(int tx, int ty, SIZE halo, RECT bounds);
+size_t FindDirtyTiles(const byte_t* previousImage, const byte_t* currentImage, SIZE imageSize, bool* dirtyTiles);
+void   CopyTile(const byte_t* inputImage, byte_t* outputImage, SIZE imageSize, int tx, int ty);
+
+// +------------------------------------------------< END >-------------------------------------------------+
\ No newline at end of file